@@ -0,0 +1,251 @@
+// build cost of generated code: compiler wall time, peak RSS and object size per codegen variant
+// a synthetic corpus is generated with cppcms_tmpl_ccpp once per variant, every produced .cpp is
+// compiled against the cppcms stub (bench/stub) in a child process and measured with wait4;
+// with --prelude the generated prelude.h is precompiled first and counted as one more unit
+#include "corpus.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <dirent.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace cppcms::templates;
+
+namespace {
+	struct variant_t {
+		std::string name, options;
+	};
+
+	struct process_t {
+		int status;
+		double seconds;
+		size_t peak_rss;
+	};
+
+	std::vector<std::string> split_words(const std::string& s) {
+		std::vector<std::string> words;
+		std::istringstream ss(s);
+		std::string w;
+		while(ss >> w)
+			words.push_back(w);
+		return words;
+	}
+
+	// runs a command, its peak RSS includes waited for descendants (cc1plus under the g++ driver)
+	process_t run(const std::vector<std::string>& command) {
+		const auto start = std::chrono::steady_clock::now();
+		const pid_t pid = fork();
+		if(pid == 0) {
+			std::vector<char*> argv;
+			for(const std::string& a : command)
+				argv.push_back(const_cast<char*>(a.c_str()));
+			argv.push_back(nullptr);
+			execvp(argv[0], argv.data());
+			_exit(127);
+		}
+		process_t p { -1, 0, 0 };
+		int status = 0;
+		struct rusage usage;
+		if(pid < 0 || wait4(pid, &status, 0, &usage) != pid)
+			return p;
+		p.status = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+		p.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		p.peak_rss = static_cast<size_t>(usage.ru_maxrss) * 1024;
+		return p;
+	}
+
+	size_t file_size(const std::string& filename) {
+		struct stat st;
+		return stat(filename.c_str(), &st) == 0 ? st.st_size : 0;
+	}
+
+	bool make_dir(const std::string& dir) {
+		return mkdir(dir.c_str(), 0777) == 0 || errno == EEXIST;
+	}
+
+	std::vector<std::string> cpp_files(const std::string& dir) {
+		std::vector<std::string> files;
+		if(DIR *d = opendir(dir.c_str())) {
+			while(struct dirent *e = readdir(d)) {
+				const std::string name(e->d_name);
+				if(name.size() > 4 && name.compare(name.size() - 4, 4, ".cpp") == 0)
+					files.push_back(dir + "/" + name);
+			}
+			closedir(d);
+		}
+		return files;
+	}
+
+	struct result_t {
+		size_t units, source_bytes, object_bytes, peak_rss;
+		double seconds, max_unit_seconds;
+	};
+
+	void usage(const std::string& self) {
+		std::cerr << self << " [ --profile NAME ] [ --size SIZE ] [ --cxx g++,clang++ ] [ --cxxflags FLAGS ] [ --repeat N ]\n"
+			"\t[ --variant NAME=OPTIONS ]... [ --ccpp PATH ] [ --work DIR ]\n";
+		exit(1);
+	}
+}
+
+int main(int argc, char **argv) {
+	bench::profile_t profile = bench::profile_t::vars;
+	size_t size = 64 * 1024;
+	std::vector<std::string> compilers { getenv("CXX") ? getenv("CXX") : "c++" };
+	std::string cxxflags = "-std=c++11 -O2", ccpp = CPPCMS_TMPL_CCPP_PATH, work = "compile_bench.work";
+	int repeat = 1;
+	std::vector<variant_t> variants;
+	for(int i = 1; i < argc; ++i) {
+		const std::string v(argv[i]);
+		if(v == "--profile" && i + 1 != argc) {
+			if(!bench::parse_profile(argv[++i], profile))
+				usage(argv[0]);
+		} else if(v == "--size" && i + 1 != argc) {
+			if((size = bench::parse_size(argv[++i])) == 0)
+				usage(argv[0]);
+		} else if(v == "--cxx" && i + 1 != argc) {
+			std::string list(argv[++i]);
+			for(char& c : list)
+				if(c == ',') c = ' ';
+			compilers = split_words(list);
+		} else if(v == "--cxxflags" && i + 1 != argc) {
+			cxxflags = argv[++i];
+		} else if(v == "--repeat" && i + 1 != argc) {
+			if((repeat = atoi(argv[++i])) <= 0)
+				usage(argv[0]);
+		} else if(v == "--variant" && i + 1 != argc) {
+			const std::string spec(argv[++i]);
+			const size_t eq = spec.find('=');
+			if(eq == 0 || eq == std::string::npos)
+				usage(argv[0]);
+			variants.push_back(variant_t { spec.substr(0, eq), spec.substr(eq + 1) });
+		} else if(v == "--ccpp" && i + 1 != argc) {
+			ccpp = argv[++i];
+		} else if(v == "--work" && i + 1 != argc) {
+			work = argv[++i];
+		} else {
+			usage(argv[0]);
+		}
+	}
+	if(compilers.empty())
+		usage(argv[0]);
+	if(variants.empty()) {
+		// --split-output is given the variant's directory by the benchmark
+		variants = {
+			{ "base", "" },
+			{ "compress", "--compress-lines" },
+			{ "noline", "--no-line" },
+			{ "stream", "--stream" },
+			{ "split", "--split-output" },
+			{ "shards4", "--split-output --shards 4" },
+			{ "prelude4", "--split-output --shards 4 --prelude" }
+		};
+	}
+
+	const bench::corpus_t corpus = bench::generate(profile, size, 1, "");
+	if(!make_dir(work) || !make_dir(work + "/corpus")) {
+		std::cerr << "ERROR: could not create directory " << work << "\n";
+		return 3;
+	}
+	std::vector<std::string> sources;
+	for(const source_file_t& file : corpus.files) {
+		sources.push_back(work + "/corpus/" + file.filename);
+		std::ofstream o(sources.back());
+		if(!(o << file.content)) {
+			std::cerr << "ERROR: could not write " << sources.back() << "\n";
+			return 3;
+		}
+	}
+
+	printf("%s %s: %zu files, %zu views, compiled with %s\n", bench::profile_name(profile).c_str(), bench::format_size(size).c_str(),
+		corpus.files.size(), corpus.views, cxxflags.c_str());
+	printf("%-10s %-10s %5s %9s | %8s %8s %8s %9s | %7s %7s\n",
+		"compiler", "variant", "units", "source", "wall", "max unit", "peak", "object", "wall", "object");
+	printf("%-10s %-10s %5s %9s | %8s %8s %8s %9s | %7s %7s\n",
+		"", "", "", "KB", "s", "s", "RSS MB", "KB", "vs base", "vs base");
+	fflush(stdout);
+	for(const std::string& cxx : compilers) {
+		result_t base { 0, 0, 0, 0, 0, 0 };
+		for(size_t n = 0; n < variants.size(); ++n) {
+			const variant_t& variant = variants[n];
+			const std::string dir = work + "/" + variant.name;
+			if(!make_dir(dir)) {
+				std::cerr << "ERROR: could not create directory " << dir << "\n";
+				return 3;
+			}
+			for(const std::string& f : cpp_files(dir))
+				unlink(f.c_str());
+			unlink((dir + "/prelude.h.gch").c_str());
+
+			std::vector<std::string> command { ccpp, "-s", "bench" };
+			bool split = false, prelude = false;
+			for(const std::string& option : split_words(variant.options)) {
+				command.push_back(option);
+				if(option == "--split-output") {
+					command.push_back(dir);
+					split = true;
+				}
+				prelude = prelude || option == "--prelude";
+			}
+			if(!split) {
+				command.push_back("-o");
+				command.push_back(dir + "/skin.cpp");
+			}
+			command.insert(command.end(), sources.begin(), sources.end());
+			if(run(command).status != 0) {
+				std::cerr << "ERROR: cppcms_tmpl_ccpp failed for variant " << variant.name << "\n";
+				return 3;
+			}
+
+			// the precompiled prelude must be built with the same flags, before the units using it
+			std::vector<std::string> units = cpp_files(dir);
+			if(prelude)
+				units.insert(units.begin(), dir + "/prelude.h");
+			result_t r { 0, 0, 0, 0, 0, 0 };
+			for(const std::string& unit : units) {
+				const bool header = unit.compare(unit.size() - 2, 2, ".h") == 0;
+				const std::string object = header ? unit + ".gch" : unit.substr(0, unit.size() - 4) + ".o";
+				std::vector<std::string> compile { cxx };
+				for(const std::string& flag : split_words(cxxflags))
+					compile.push_back(flag);
+				const std::vector<std::string> rest { "-I", BENCH_STUB_DIR, "-I", BENCH_RUNTIME_DIR, header ? "-xc++-header" : "-c", unit, "-o", object };
+				compile.insert(compile.end(), rest.begin(), rest.end());
+				double best = 1e9;
+				for(int i = 0; i < repeat; ++i) {
+					const process_t p = run(compile);
+					if(p.status != 0) {
+						std::cerr << "ERROR: " << cxx << " failed on " << unit << "\n";
+						return 3;
+					}
+					best = std::min(best, p.seconds);
+					r.peak_rss = std::max(r.peak_rss, p.peak_rss);
+				}
+				r.units++;
+				r.source_bytes += file_size(unit);
+				if(!header)
+					r.object_bytes += file_size(object);
+				r.seconds += best;
+				r.max_unit_seconds = std::max(r.max_unit_seconds, best);
+			}
+			if(n == 0)
+				base = r;
+
+			// max unit is the critical path of a parallel build
+			printf("%-10s %-10s %5zu %9zu | %8.2f %8.2f %8.1f %9zu | %6.2fx %6.2fx\n",
+				cxx.c_str(), variant.name.c_str(), r.units, r.source_bytes / 1024,
+				r.seconds, r.max_unit_seconds, r.peak_rss / (1024.0 * 1024.0), r.object_bytes / 1024,
+				r.seconds / base.seconds, double(r.object_bytes) / base.object_bytes);
+			fflush(stdout);
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,224 @@
+#include "corpus.h"
+#include <cstdlib>
+
+namespace cppcms { namespace templates { namespace bench {
+	namespace {
+		// xorshift, same sequence on every platform
+		class random_t {
+			unsigned state_;
+		public:
+			explicit random_t(unsigned seed) : state_(seed ? seed : 1) {}
+			unsigned next(unsigned n) {
+				state_ ^= state_ << 13;
+				state_ ^= state_ >> 17;
+				state_ ^= state_ << 5;
+				return state_ % n;
+			}
+		};
+
+		const char *words[] = { "lorem", "ipsum", "dolor", "sit", "amet", "consectetur", "adipiscing", "elit", "sed", "do", "eiusmod", "tempor" };
+		const char *blocks[] = { "div", "section", "p", "article", "aside", "li" };
+		const char *page_strings[] = { "title", "user.name", "user.email", "footer" };
+		const char *item_strings[] = { "it.title", "it.url", "it.summary" };
+		const char *filters[] = { "", "", " | raw", " | urlencode" };
+
+		class writer_t {
+			std::string& o_;
+			random_t& r_;
+			size_t& tags_;
+		public:
+			writer_t(std::string& o, random_t& r, size_t& tags) : o_(o), r_(r), tags_(tags) {}
+
+			void indent(int depth) { o_.append(depth, '\t'); }
+			void tag(const std::string& body) { o_ += "<% " + body + " %>"; tags_++; }
+			void var(const std::string& body) { o_ += "<%= " + body + " %>"; tags_++; }
+
+			void words(int n) {
+				for(int i = 0; i < n; ++i) {
+					if(i) o_ += ' ';
+					o_ += bench::words[r_.next(12)];
+				}
+			}
+
+			void markup(int depth, int lines) {
+				for(int i = 0; i < lines; ++i) {
+					const char *b = blocks[r_.next(6)];
+					indent(depth);
+					o_ += std::string("<") + b + " class=\"c" + std::to_string(r_.next(50)) + "\">";
+					if(i % 4 == 3) {
+						// translated text, drawing the same numbers as plain text so the rest of the corpus stays the same
+						std::string text;
+						writer_t(text, r_, tags_).words(4 + r_.next(12));
+						tag("gt \"" + text + "\"");
+					} else {
+						words(4 + r_.next(12));
+					}
+					o_ += std::string("</") + b + ">\n";
+				}
+			}
+
+			void page_var() { var(std::string(page_strings[r_.next(4)]) + filters[r_.next(4)]); }
+			void item_var() { var(std::string(item_strings[r_.next(3)]) + filters[r_.next(4)]); }
+
+			void variables(int depth, int lines, bool in_item) {
+				for(int i = 0; i < lines; ++i) {
+					indent(depth);
+					o_ += "<span>";
+					if(i % 4 == 1) {
+						o_ += "<a href=\"";
+						tag("url \"/blog/summary\"");
+						o_ += "\">blog</a> ";
+					}
+					for(int j = 0; j < 3; ++j) {
+						if(in_item && r_.next(2))
+							item_var();
+						else
+							page_var();
+						o_ += ' ';
+					}
+					if(i % 4 == 3)
+						tag("ngt \"one item\", \"{1} items\", count using count");
+					else
+						var("count");
+					o_ += "</span>\n";
+				}
+			}
+
+			void loop(int depth, int nesting, int lines, bool vars) {
+				indent(depth); tag("foreach it in items"); o_ += "\n";
+				indent(depth); o_ += "<ul>\n";
+				indent(depth + 1); tag("separator"); o_ += "<li class=\"sep\"></li>\n";
+				indent(depth + 1); tag("item"); o_ += "<li><a href=\""; tag("url \"/item\" using it.title"); o_ += "\">"; item_var(); o_ += "</a>\n";
+				body(depth + 2, nesting - 1, lines, vars, true);
+				indent(depth + 1); tag("end item"); o_ += "</li>\n";
+				indent(depth); o_ += "</ul>\n";
+				indent(depth); tag("empty"); o_ += "<p>no items</p>\n";
+				indent(depth); tag("end foreach"); o_ += "\n";
+			}
+
+			void condition(int depth, int nesting, int lines, bool vars, bool in_item) {
+				static const char *conditions[] = { "if logged_in", "if not empty title", "if ( content.count > 3 )" };
+				indent(depth); tag(in_item && r_.next(2) ? "if it.active" : conditions[r_.next(3)]); o_ += "\n";
+				body(depth + 1, nesting - 1, lines, vars, in_item);
+				indent(depth); tag("else"); o_ += "\n";
+				markup(depth + 1, 1);
+				indent(depth); tag("end if"); o_ += "\n";
+			}
+
+			void body(int depth, int nesting, int lines, bool vars, bool in_item) {
+				if(vars)
+					variables(depth, lines, in_item);
+				else
+					markup(depth, lines);
+				if(nesting <= 0)
+					return;
+				if(in_item || r_.next(2))
+					condition(depth, nesting, lines, vars, in_item);
+				else
+					loop(depth, nesting, lines, vars);
+			}
+		};
+
+		struct shape_t {
+			int views_per_file, templates_per_view, nesting, lines;
+			bool vars;
+		};
+
+		shape_t shape(profile_t profile) {
+			switch(profile) {
+			case profile_t::html: return shape_t { 20, 3, 1, 40, false };
+			case profile_t::vars: return shape_t { 20, 3, 1, 20, true };
+			case profile_t::nested: return shape_t { 20, 3, 8, 2, true };
+			case profile_t::many: return shape_t { 1, 2, 2, 4, true };
+			}
+			return shape_t { 20, 3, 1, 10, false };
+		}
+	}
+
+	corpus_t generate(profile_t profile, size_t bytes, unsigned seed, const std::string& skin) {
+		corpus_t corpus { {}, 0, 0, 0 };
+		random_t r(seed);
+		const shape_t s = shape(profile);
+		const std::string prefix = profile_name(profile);
+		while(corpus.bytes < bytes) {
+			std::string content;
+			writer_t w(content, r, corpus.tags);
+			w.tag("c++ #include \"bench_data.h\""); content += "\n";
+			w.tag("html"); content += "\n";
+			w.tag(skin.empty() ? std::string("skin") : "skin " + skin); content += "\n";
+			for(int v = 0; v < s.views_per_file && corpus.bytes + content.size() < bytes; ++v) {
+				const std::string view = prefix + "_" + std::to_string(corpus.views++);
+				w.tag("view " + view + " uses bench_data::page"); content += "\n";
+				for(int t = 0; t < s.templates_per_view; ++t) {
+					w.tag(t == 0 ? std::string("template render()") : "template part" + std::to_string(t) + "()"); content += "\n";
+					if(t == 0) {
+						for(int c = 1; c < s.templates_per_view; ++c) {
+							w.tag("include part" + std::to_string(c) + "()"); content += "\n";
+						}
+					}
+					// the last part is a fragment cached across renders
+					const bool cached = t > 0 && t == s.templates_per_view - 1;
+					if(cached) {
+						w.tag("cache \"" + view + "_part" + std::to_string(t) + "\""); content += "\n";
+					}
+					w.body(1, s.nesting, s.lines, s.vars, false);
+					if(cached) {
+						w.tag("end cache"); content += "\n";
+					}
+					w.tag("end template"); content += "\n";
+				}
+				w.tag("end view"); content += "\n";
+			}
+			w.tag("end skin"); content += "\n";
+			corpus.bytes += content.size();
+			corpus.files.push_back(source_file_t { prefix + "_" + std::to_string(corpus.files.size()) + ".tmpl", content });
+		}
+		return corpus;
+	}
+
+	const std::vector<profile_t>& profiles() {
+		static const std::vector<profile_t> all { profile_t::html, profile_t::vars, profile_t::nested, profile_t::many };
+		return all;
+	}
+
+	std::string profile_name(profile_t profile) {
+		switch(profile) {
+		case profile_t::html: return "html";
+		case profile_t::vars: return "vars";
+		case profile_t::nested: return "nested";
+		case profile_t::many: return "many";
+		}
+		return "unknown";
+	}
+
+	bool parse_profile(const std::string& name, profile_t& profile) {
+		for(profile_t p : profiles()) {
+			if(profile_name(p) == name) {
+				profile = p;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	size_t parse_size(const std::string& size) {
+		char *end = nullptr;
+		const double value = strtod(size.c_str(), &end);
+		if(end == size.c_str() || value <= 0)
+			return 0;
+		const std::string unit(end);
+		if(unit.empty()) return static_cast<size_t>(value);
+		if(unit == "K" || unit == "k") return static_cast<size_t>(value * 1024);
+		if(unit == "M" || unit == "m") return static_cast<size_t>(value * 1024 * 1024);
+		if(unit == "G" || unit == "g") return static_cast<size_t>(value * 1024 * 1024 * 1024);
+		return 0;
+	}
+
+	std::string format_size(size_t bytes) {
+		if(bytes >= 1024 * 1024)
+			return std::to_string(bytes / (1024 * 1024)) + "M";
+		if(bytes >= 1024)
+			return std::to_string(bytes / 1024) + "K";
+		return std::to_string(bytes);
+	}
+}}}
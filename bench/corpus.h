@@ -0,0 +1,32 @@
+#ifndef CPPCMS_TEMPLATE_BENCH_CORPUS_H
+#define CPPCMS_TEMPLATE_BENCH_CORPUS_H
+#include "parser_source.h"
+#include <string>
+#include <vector>
+
+namespace cppcms { namespace templates { namespace bench {
+	// synthetic, deterministic skins of a given size
+	// every generated view uses bench_data::page (bench/stub/bench_data.h)
+	enum class profile_t {
+		html, // mostly static markup
+		vars, // many variables and filters per line
+		nested, // deeply nested if/foreach
+		many // many small files and views
+	};
+
+	struct corpus_t {
+		std::vector<source_file_t> files;
+		size_t bytes, tags, views;
+	};
+
+	// an empty skin name writes <% skin %> so the name can be given to cppcms_tmpl_ccpp -s
+	corpus_t generate(profile_t profile, size_t bytes, unsigned seed = 1, const std::string& skin = "bench");
+
+	const std::vector<profile_t>& profiles();
+	std::string profile_name(profile_t profile);
+	bool parse_profile(const std::string& name, profile_t& profile);
+	// "64K", "10M", "1G" or plain bytes, 0 on error
+	size_t parse_size(const std::string& size);
+	std::string format_size(size_t bytes);
+}}}
+#endif
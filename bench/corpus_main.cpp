@@ -0,0 +1,71 @@
+// writes synthetic skins to a directory, for compiling or inspecting them outside of benchmarks
+#include "corpus.h"
+#include <iostream>
+#include <fstream>
+#include <cerrno>
+#include <sys/stat.h>
+
+using namespace cppcms::templates;
+
+static void usage(const std::string& self) {
+	std::cerr << self << " --profile html|vars|nested|many --size SIZE[K|M|G] [ --seed N ] [ --skin NAME | --default-skin ] --out DIR | --out-file FILE\n";
+	exit(1);
+}
+
+int main(int argc, char **argv) {
+	bench::profile_t profile = bench::profile_t::html;
+	size_t size = 0;
+	unsigned seed = 1;
+	std::string dir, file_name, skin = "bench";
+	for(int i = 1; i < argc; ++i) {
+		const std::string v(argv[i]);
+		if(v == "--profile" && i + 1 != argc) {
+			if(!bench::parse_profile(argv[++i], profile))
+				usage(argv[0]);
+		} else if(v == "--size" && i + 1 != argc) {
+			size = bench::parse_size(argv[++i]);
+		} else if(v == "--seed" && i + 1 != argc) {
+			seed = atoi(argv[++i]);
+		} else if(v == "--skin" && i + 1 != argc) {
+			skin = argv[++i];
+		} else if(v == "--default-skin") {
+			skin.clear();
+		} else if(v == "--out" && i + 1 != argc) {
+			dir = argv[++i];
+		} else if(v == "--out-file" && i + 1 != argc) {
+			file_name = argv[++i];
+		} else {
+			usage(argv[0]);
+		}
+	}
+	if(size == 0 || dir.empty() == file_name.empty())
+		usage(argv[0]);
+
+	const bench::corpus_t corpus = bench::generate(profile, size, seed, skin);
+	if(!file_name.empty()) {
+		// all files one after another, a single input for cppcms_tmpl_ccpp
+		std::ofstream o(file_name);
+		for(const source_file_t& file : corpus.files)
+			o << file.content;
+		if(!o) {
+			std::cerr << "ERROR: could not write " << file_name << "\n";
+			return 3;
+		}
+		std::cerr << corpus.files.size() << " files, " << corpus.views << " views, " << corpus.tags << " tags, " << corpus.bytes << " bytes\n";
+		return 0;
+	}
+	if(mkdir(dir.c_str(), 0777) != 0 && errno != EEXIST) {
+		std::cerr << "ERROR: could not create directory " << dir << "\n";
+		return 3;
+	}
+	for(const source_file_t& file : corpus.files) {
+		std::ofstream o(dir + "/" + file.filename);
+		if(!(o << file.content)) {
+			std::cerr << "ERROR: could not write " << dir << "/" << file.filename << "\n";
+			return 3;
+		}
+		std::cout << file.filename << "\n";
+	}
+	std::cerr << corpus.files.size() << " files, " << corpus.views << " views, " << corpus.tags << " tags, " << corpus.bytes << " bytes\n";
+	return 0;
+}
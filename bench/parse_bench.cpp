@@ -0,0 +1,155 @@
+// parse and codegen throughput on synthetic skins
+// every configuration runs in a forked process, so peak RSS is not shared between them
+#include "corpus.h"
+#include "parser.h"
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace cppcms::templates;
+
+namespace {
+	// discards generated code, counting its size
+	class null_buffer : public std::streambuf {
+	public:
+		size_t bytes = 0;
+	protected:
+		virtual int overflow(int c) { bytes++; return traits_type::not_eof(c); }
+		virtual std::streamsize xsputn(const char *, std::streamsize n) { bytes += n; return n; }
+	};
+
+	size_t peak_rss() {
+		struct rusage usage;
+		getrusage(RUSAGE_SELF, &usage);
+		return static_cast<size_t>(usage.ru_maxrss) * 1024;
+	}
+
+	double seconds_since(std::chrono::steady_clock::time_point start) {
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	struct budget_t {
+		double parse, codegen; // MB/s of template source, 0 = none
+	};
+
+	// returns false when under budget
+	bool run(bench::profile_t profile, size_t size, int repeat, const budget_t& budget) {
+		const bench::corpus_t corpus = bench::generate(profile, size);
+		const size_t base_rss = peak_rss();
+		double parse_time = 1e9, codegen_time = 1e9;
+		size_t parse_rss = 0, codegen_rss = 0, output_bytes = 0;
+		for(int i = 0; i < repeat; ++i) {
+			template_parser p(corpus.files);
+			auto start = std::chrono::steady_clock::now();
+			p.parse();
+			parse_time = std::min(parse_time, seconds_since(start));
+			// peaks are taken in the first round, later ones only see the highest one so far
+			if(i == 0)
+				parse_rss = peak_rss();
+
+			generator::context context;
+			null_buffer null;
+			std::ostream o(&null);
+			start = std::chrono::steady_clock::now();
+			p.write(context, o);
+			codegen_time = std::min(codegen_time, seconds_since(start));
+			if(i == 0)
+				codegen_rss = peak_rss();
+			output_bytes = null.bytes;
+			p.tree()->clear();
+		}
+
+		const double mb = corpus.bytes / (1024.0 * 1024.0);
+		printf("%-7s %6s %6zu %7zu %9zu | %8.1f %11.0f %7.1f | %8.1f %11.0f %7.1f %8.1f\n",
+			bench::profile_name(profile).c_str(), bench::format_size(size).c_str(),
+			corpus.files.size(), corpus.views, corpus.tags,
+			mb / parse_time, corpus.tags / parse_time, (parse_rss - base_rss) / (1024.0 * 1024.0),
+			mb / codegen_time, corpus.tags / codegen_time, (codegen_rss - parse_rss) / (1024.0 * 1024.0),
+			output_bytes / (1024.0 * 1024.0));
+		fflush(stdout);
+		return (budget.parse <= 0 || mb / parse_time >= budget.parse) && (budget.codegen <= 0 || mb / codegen_time >= budget.codegen);
+	}
+
+	void usage(const std::string& self) {
+		std::cerr << self << " [ --profile all|html|vars|nested|many ] [ --sizes 64K,1M,16M ] [ --repeat N ]\n"
+			"\t[ --budget-parse MB/s ] [ --budget-codegen MB/s ]\n";
+		exit(1);
+	}
+}
+
+int main(int argc, char **argv) {
+	std::vector<bench::profile_t> profiles = bench::profiles();
+	std::vector<size_t> sizes { 64 * 1024, 1024 * 1024, 16 * 1024 * 1024 };
+	int repeat = 3;
+	budget_t budget { 0, 0 };
+	for(int i = 1; i < argc; ++i) {
+		const std::string v(argv[i]);
+		if(v == "--profile" && i + 1 != argc) {
+			const std::string name(argv[++i]);
+			bench::profile_t profile;
+			if(name == "all")
+				profiles = bench::profiles();
+			else if(bench::parse_profile(name, profile))
+				profiles = { profile };
+			else
+				usage(argv[0]);
+		} else if(v == "--sizes" && i + 1 != argc) {
+			sizes.clear();
+			std::string list(argv[++i]);
+			size_t pos = 0;
+			while(pos <= list.size()) {
+				size_t next = list.find(',', pos);
+				if(next == std::string::npos)
+					next = list.size();
+				const size_t size = bench::parse_size(list.substr(pos, next - pos));
+				if(size == 0)
+					usage(argv[0]);
+				sizes.push_back(size);
+				pos = next + 1;
+			}
+		} else if(v == "--repeat" && i + 1 != argc) {
+			repeat = atoi(argv[++i]);
+			if(repeat <= 0)
+				usage(argv[0]);
+		} else if(v == "--budget-parse" && i + 1 != argc) {
+			budget.parse = atof(argv[++i]);
+		} else if(v == "--budget-codegen" && i + 1 != argc) {
+			budget.codegen = atof(argv[++i]);
+		} else {
+			usage(argv[0]);
+		}
+	}
+
+	// MB/s and tags/s are of template source for both phases; peak RSS of parse is above the generated
+	// corpus, the one of codegen above the peak of parse (the tree it writes stays in memory)
+	printf("%-7s %6s %6s %7s %9s | %8s %11s %7s | %8s %11s %7s %8s\n",
+		"profile", "size", "files", "views", "tags", "parse", "", "peak", "codegen", "", "peak", "output");
+	printf("%-7s %6s %6s %7s %9s | %8s %11s %7s | %8s %11s %7s %8s\n",
+		"", "", "", "", "", "MB/s", "tags/s", "RSS MB", "MB/s", "tags/s", "RSS MB", "MB");
+	fflush(stdout);
+	int status = 0;
+	for(bench::profile_t profile : profiles) {
+		for(size_t size : sizes) {
+			const pid_t pid = fork();
+			if(pid == 0)
+				_exit(run(profile, size, repeat, budget) ? 0 : 4);
+			int child = 0;
+			if(pid < 0 || waitpid(pid, &child, 0) != pid || !WIFEXITED(child)) {
+				std::cerr << "ERROR: benchmark process failed\n";
+				return 3;
+			}
+			if(WEXITSTATUS(child) == 4) {
+				std::cerr << "FAILED: " << bench::profile_name(profile) << " " << bench::format_size(size) << " is under throughput budget\n";
+				status = 4;
+			} else if(WEXITSTATUS(child) != 0) {
+				return 3;
+			}
+		}
+	}
+	return status;
+}
@@ -0,0 +1,273 @@
+// rendering cost of generated views against the cppcms stub (bench/stub)
+// every skin linked in is measured; skins holding the same views, generated with
+// different cppcms_tmpl_ccpp options, are compared against the baseline skin, timing and output
+#include "bench_data.h"
+#include "magic_data.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <new>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+	size_t allocations = 0;
+}
+
+void *operator new(size_t n) {
+	allocations++;
+	if(void *p = malloc(n ? n : 1))
+		return p;
+	throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+namespace {
+	// keeps its storage between renders, so only allocations made by views are counted
+	class string_buffer : public std::streambuf {
+	public:
+		std::string data;
+		string_buffer() { data.reserve(1 << 20); }
+		void reset() { data.clear(); }
+	protected:
+		virtual int overflow(int c) {
+			if(c != traits_type::eof())
+				data += static_cast<char>(c);
+			return traits_type::not_eof(c);
+		}
+		virtual std::streamsize xsputn(const char *s, std::streamsize n) { data.append(s, n); return n; }
+	};
+
+	void fill(bench_data::page& page) {
+		page.title = "Synthetic <page> & \"title\"";
+		page.footer = "footer text, (c) nobody";
+		page.user.name = "Jane O'Neil";
+		page.user.email = "jane@example.com";
+		page.count = 12;
+		page.logged_in = true;
+		for(int i = 0; i < page.count; ++i) {
+			const std::string n = std::to_string(i);
+			page.items.push_back(bench_data::item { "Item " + n + " & more", "/items/" + n + "?a=1&b=<2>", "A summary of item " + n + " that is a bit longer than its title.", i % 3 != 0 });
+		}
+		// a catalog of a few hundred messages, like the one of a real application
+		for(int i = 0; i < 300; ++i)
+			cppcms::locale::catalog()["message " + std::to_string(i)] = "translated message " + std::to_string(i);
+		cppcms::locale::catalog()["{1} items"] = "{1} articles";
+	}
+
+	struct result_t {
+		std::string skin, view, error;
+		std::string output; // of the first render
+		const cppcms::views::generator::entry_t *entry;
+		cppcms::base_content *content;
+		double ns;
+		size_t bytes;
+		double allocs;
+	};
+
+	const char *const unstable_output = "output of later renders differs from the first one";
+
+	// renders for at least min_time, keeping the best time per render
+	void sample(result_t& r, double min_time) {
+		string_buffer buffer;
+		std::ostream out(&buffer);
+		auto render = [&]() {
+			buffer.reset();
+			r.entry->create(out, *r.content)->render();
+		};
+		try {
+			if(r.bytes == 0) {
+				cppcms::base_view::rendered_by_default() = false;
+				render();
+				if(cppcms::base_view::rendered_by_default()) {
+					r.error = "no render()";
+					return;
+				}
+				r.output = buffer.data;
+			}
+			size_t iterations = 0, batch = 1;
+			const size_t start_allocations = allocations;
+			const auto start = std::chrono::steady_clock::now();
+			double elapsed = 0;
+			while(elapsed < min_time) {
+				for(size_t i = 0; i < batch; ++i)
+					render();
+				iterations += batch;
+				batch *= 2;
+				elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			}
+			const double ns = elapsed * 1e9 / iterations;
+			if(r.ns == 0 || ns < r.ns)
+				r.ns = ns;
+			r.allocs = double(allocations - start_allocations) / iterations;
+			r.bytes = buffer.data.size();
+			if(buffer.data != r.output)
+				r.error = unstable_output;
+		} catch(const std::exception& e) {
+			r.error = e.what();
+		}
+	}
+
+	std::string profile_of(const std::string& view) {
+		return view.substr(0, view.find('_'));
+	}
+
+	// where the output of a view differs from the one of the baseline, empty when it does not
+	std::string difference(const std::string& output, const std::string& baseline) {
+		if(output == baseline)
+			return std::string();
+		size_t i = 0;
+		while(i < output.size() && i < baseline.size() && output[i] == baseline[i])
+			i++;
+		std::ostringstream ss;
+		ss << "output differs from the baseline at byte " << i << " of " << output.size() << " (baseline " << baseline.size() << ")";
+		return ss.str();
+	}
+
+	void usage(const std::string& self) {
+		std::cerr << self << " [ --filter SUBSTRING ] [ --baseline SKIN ] [ --min-time SECONDS ] [ --rounds N ] [ --quiet ]\n"
+			"\t[ --allow-diff SKIN,... ]\n";
+		exit(1);
+	}
+}
+
+int main(int argc, char **argv) {
+	std::string filter, baseline = "base";
+	double min_time = 0.2;
+	int rounds = 5;
+	bool quiet = false;
+	std::set<std::string> allow_diff; // skins whose output is expected to differ from the baseline
+	for(int i = 1; i < argc; ++i) {
+		const std::string v(argv[i]);
+		if(v == "--filter" && i + 1 != argc) {
+			filter = argv[++i];
+		} else if(v == "--baseline" && i + 1 != argc) {
+			baseline = argv[++i];
+		} else if(v == "--min-time" && i + 1 != argc) {
+			min_time = atof(argv[++i]);
+		} else if(v == "--rounds" && i + 1 != argc) {
+			rounds = atoi(argv[++i]);
+			if(rounds <= 0)
+				usage(argv[0]);
+		} else if(v == "--quiet") {
+			quiet = true;
+		} else if(v == "--allow-diff" && i + 1 != argc) {
+			std::istringstream list(argv[++i]);
+			for(std::string skin; std::getline(list, skin, ',');)
+				allow_diff.insert(skin);
+		} else {
+			usage(argv[0]);
+		}
+	}
+
+	cppcms::application app;
+	bench_data::page page;
+	data::master master;
+	fill(page);
+	page.app(app);
+	master.app(app);
+	std::map<std::type_index, cppcms::base_content*> contents {
+		{ std::type_index(typeid(bench_data::page)), &page },
+		{ std::type_index(typeid(data::master)), &master }
+	};
+
+	std::vector<result_t> results;
+	for(const cppcms::views::generator *g : cppcms::views::pool::instance().generators()) {
+		for(const cppcms::views::generator::entry_t& entry : g->entries()) {
+			if((g->name() + "::" + entry.view).find(filter) == std::string::npos)
+				continue;
+			auto content = contents.find(entry.content);
+			if(content != contents.end())
+				results.push_back(result_t { g->name(), entry.view, "", "", &entry, content->second, 0, 0, 0 });
+		}
+	}
+	// the same view of every skin is sampled in turns, so that a noisy moment does not favor one variant
+	std::map<std::string, std::vector<result_t*>> views;
+	for(result_t& r : results)
+		views[r.view].push_back(&r);
+	for(auto& view : views) {
+		for(int i = 0; i < rounds; ++i) {
+			for(result_t *r : view.second) {
+				if(r->error.empty())
+					sample(*r, min_time / rounds);
+			}
+		}
+	}
+	std::map<std::string, const result_t*> base; // view name -> baseline result
+	for(const result_t& r : results) {
+		if(r.skin == baseline && r.error.empty())
+			base[r.view] = &r;
+	}
+	// a variant that renders something else than the baseline is not a faster way of doing the same
+	size_t mismatches = 0;
+	for(const result_t& r : results) {
+		if(r.error == unstable_output) {
+			fprintf(stderr, "%s %s: %s\n", r.skin.c_str(), r.view.c_str(), r.error.c_str());
+			mismatches++;
+		}
+		auto b = base.find(r.view);
+		if(r.skin == baseline || b == base.end() || !r.error.empty())
+			continue;
+		const std::string diff = difference(r.output, b->second->output);
+		if(diff.empty())
+			continue;
+		if(allow_diff.count(r.skin)) {
+			if(!quiet)
+				printf("%-22s %-14s %s (allowed)\n", r.skin.c_str(), r.view.c_str(), diff.c_str());
+			continue;
+		}
+		fprintf(stderr, "%s %s: %s\n", r.skin.c_str(), r.view.c_str(), diff.c_str());
+		mismatches++;
+	}
+
+	if(!quiet)
+		printf("%-22s %-14s %12s %10s %10s %8s\n", "skin", "view", "ns/render", "bytes", "allocs", "vs base");
+	struct summary_t {
+		double ns = 0, log_ratio = 0;
+		size_t bytes = 0, views = 0, compared = 0;
+		double allocs = 0;
+	};
+	std::map<std::pair<std::string, std::string>, summary_t> summary; // (profile, skin)
+	for(const result_t& r : results) {
+		if(!r.error.empty()) {
+			if(!quiet)
+				printf("%-22s %-14s %s\n", r.skin.c_str(), r.view.c_str(), r.error.c_str());
+			continue;
+		}
+		auto b = base.find(r.view);
+		const bool compared = r.skin != baseline && b != base.end();
+		if(!quiet) {
+			printf("%-22s %-14s %12.0f %10zu %10.1f", r.skin.c_str(), r.view.c_str(), r.ns, r.bytes, r.allocs);
+			if(compared)
+				printf(" %7.2fx", b->second->ns / r.ns);
+			printf("\n");
+		}
+		summary_t& s = summary[std::make_pair(profile_of(r.view), r.skin)];
+		s.ns += r.ns;
+		s.bytes += r.bytes;
+		s.allocs += r.allocs;
+		s.views++;
+		if(compared) {
+			s.log_ratio += std::log(b->second->ns / r.ns);
+			s.compared++;
+		}
+	}
+
+	// speedup is the geometric mean over views of the profile, > 1 is faster than the baseline
+	printf("\n%-8s %-22s %6s %12s %10s %10s %8s\n", "profile", "skin", "views", "ns/view", "bytes/view", "allocs", "speedup");
+	for(const auto& item : summary) {
+		const summary_t& s = item.second;
+		printf("%-8s %-22s %6zu %12.0f %10zu %10.1f", item.first.first.c_str(), item.first.second.c_str(), s.views,
+			s.ns / s.views, s.bytes / s.views, s.allocs / s.views);
+		if(s.compared)
+			printf(" %7.2fx", std::exp(s.log_ratio / s.compared));
+		printf("\n");
+	}
+	return mismatches ? 5 : 0;
+}
@@ -0,0 +1,26 @@
+#ifndef CPPCMS_TEMPLATE_BENCH_DATA_H
+#define CPPCMS_TEMPLATE_BENCH_DATA_H
+// content of the synthetic skins written by bench/corpus.cpp
+#include "cppcms_stub.h"
+#include <string>
+#include <vector>
+
+namespace bench_data {
+	struct item {
+		std::string title, url, summary;
+		bool active;
+	};
+
+	struct user_t {
+		std::string name, email;
+	};
+
+	struct page : public cppcms::base_content {
+		std::string title, footer;
+		user_t user;
+		int count;
+		bool logged_in;
+		std::vector<item> items;
+	};
+}
+#endif
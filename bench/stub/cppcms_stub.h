@@ -0,0 +1,395 @@
+#ifndef CPPCMS_TEMPLATE_BENCH_CPPCMS_STUB_H
+#define CPPCMS_TEMPLATE_BENCH_CPPCMS_STUB_H
+// minimal header-only stand-in for the parts of cppcms used by generated views,
+// close enough in cost (type erased filters, catalog lookups, per render view objects)
+// to compare code generation modes; not a replacement for real cppcms
+#include <cctype>
+#include <climits>
+#include <cstdlib>
+#include <cstdio>
+#include <functional>
+#include <locale>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <typeindex>
+#include <vector>
+
+#define CPPCMS_TYPEOF(x) decltype(x)
+
+namespace cppcms {
+	class cache_interface {
+		std::map<std::string, std::string> frames_;
+	public:
+		bool fetch_frame(const std::string& key, std::string& result, bool = false) {
+			auto i = frames_.find(key);
+			if(i == frames_.end())
+				return false;
+			result = i->second;
+			return true;
+		}
+		void store_frame(const std::string& key, const std::string& frame, const std::set<std::string>& = std::set<std::string>(), int = INT_MAX, bool = false) {
+			frames_[key] = frame;
+		}
+		void clear() { frames_.clear(); }
+	};
+
+	// keys are looked up and their patterns expanded on every call, as cppcms does
+	class url_mapper {
+		std::string root_ = "/app";
+		std::map<std::string, std::string> patterns_ { { "/blog/summary", "/blog" }, { "/item", "/items/{1}" }, { "/home", "/{lang}/home" } };
+		std::map<std::string, std::string> values_; // set_value, substituted for {name}
+
+		void write(std::ostream& out, const char *path, const std::vector<std::string>& args) {
+			auto i = patterns_.find(path);
+			out << root_;
+			if(i == patterns_.end()) {
+				out << path;
+				for(const std::string& a : args)
+					out << '/' << a;
+				return;
+			}
+			const std::string& pattern = i->second;
+			for(size_t k = 0; k < pattern.size(); ++k) {
+				size_t end;
+				if(pattern[k] == '{' && (end = pattern.find('}', k)) != std::string::npos) {
+					const size_t n = atoi(pattern.c_str() + k + 1);
+					auto value = values_.find(pattern.substr(k + 1, end - k - 1));
+					if(n >= 1 && n <= args.size())
+						out << args[n - 1];
+					else if(value != values_.end())
+						out << value->second;
+					k = end;
+				} else {
+					out << pattern[k];
+				}
+			}
+		}
+	public:
+		void root(const std::string& r) { root_ = r; }
+		void set_value(const std::string& key, const std::string& value) { values_[key] = value; }
+		void clear_value(const std::string& key) { values_.erase(key); }
+		void map(std::ostream& out, const char *path) { write(out, path, std::vector<std::string>()); }
+		template<typename... Args>
+		void map(std::ostream& out, const char *path, const Args&... args) {
+			std::vector<std::string> values;
+			int expand[] = { 0, (values.push_back(to_string(out, args)), 0)... };
+			(void)expand;
+			write(out, path, values);
+		}
+		template<typename T>
+		static std::string to_string(std::ostream& out, const T& value) {
+			std::ostringstream ss;
+			ss.imbue(out.getloc());
+			ss << value;
+			return ss.str();
+		}
+	};
+
+	class session_interface {
+	public:
+		std::string get_csrf_token() { return "0123456789abcdef"; }
+		std::string get_csrf_token_cookie_name() { return "_csrf"; }
+	};
+
+	class application {
+		cache_interface cache_;
+		url_mapper mapper_;
+		session_interface session_;
+	public:
+		virtual ~application() {}
+		cache_interface& cache() { return cache_; }
+		url_mapper& mapper() { return mapper_; }
+		session_interface& session() { return session_; }
+	};
+
+	class base_content {
+		application *app_ = nullptr;
+	public:
+		virtual ~base_content() {}
+		application& app() {
+			if(!app_)
+				throw std::logic_error("no application assigned to content");
+			return *app_;
+		}
+		void app(application& a) { app_ = &a; }
+		void reset_app() { app_ = nullptr; }
+
+		class app_guard {
+			base_content& content_;
+		public:
+			app_guard(base_content& content, base_content& parent) : content_(content) { content_.app(parent.app()); }
+			~app_guard() { content_.reset_app(); }
+		};
+	};
+
+	// output written while alive goes to the original stream and to a copy
+	class copy_filter {
+		class tee : public std::streambuf {
+		public:
+			std::streambuf *target;
+			std::string copy;
+		protected:
+			virtual int overflow(int c) {
+				if(c != traits_type::eof()) {
+					copy += static_cast<char>(c);
+					return target->sputc(static_cast<char>(c));
+				}
+				return traits_type::not_eof(c);
+			}
+			virtual std::streamsize xsputn(const char *s, std::streamsize n) {
+				copy.append(s, n);
+				return target->sputn(s, n);
+			}
+		};
+		std::ostream& out_;
+		tee tee_;
+		bool detached_ = false;
+	public:
+		explicit copy_filter(std::ostream& out) : out_(out) { tee_.target = out.rdbuf(&tee_); }
+		std::string detach() {
+			if(!detached_) {
+				out_.rdbuf(tee_.target);
+				detached_ = true;
+			}
+			return std::move(tee_.copy);
+		}
+		~copy_filter() { detach(); }
+	};
+
+	class triggers_recorder {
+		std::set<std::string> triggers_;
+	public:
+		explicit triggers_recorder(cache_interface&) {}
+		std::set<std::string> detach() { return std::move(triggers_); }
+	};
+
+	class base_view {
+		std::ostream& out_;
+	public:
+		explicit base_view(std::ostream& out) : out_(out) {}
+		virtual ~base_view() {}
+		virtual void render() { rendered_by_default() = true; }
+		std::ostream& out() { return out_; }
+		// stub only: set when a view does not override render()
+		static bool& rendered_by_default() { static bool flag = false; return flag; }
+	};
+
+	namespace filters {
+		// type erased reference to any streamable value, as cppcms::filters::streamable
+		class streamable {
+			const void *ptr_;
+			void (*to_stream_)(std::ostream&, const void*);
+			std::string (*to_string_)(std::ios&, const void*);
+		public:
+			template<typename T>
+			streamable(const T& value)
+				: ptr_(&value)
+				, to_stream_([](std::ostream& o, const void *p) { o << *static_cast<const T*>(p); })
+				, to_string_([](std::ios& ios, const void *p) {
+					std::ostringstream ss;
+					ss.copyfmt(ios);
+					ss << *static_cast<const T*>(p);
+					return ss.str();
+				}) {}
+			streamable(const std::string& value)
+				: ptr_(&value)
+				, to_stream_([](std::ostream& o, const void *p) { o << *static_cast<const std::string*>(p); })
+				, to_string_([](std::ios&, const void *p) { return *static_cast<const std::string*>(p); }) {}
+			streamable(const char *value)
+				: ptr_(value)
+				, to_stream_([](std::ostream& o, const void *p) { o << static_cast<const char*>(p); })
+				, to_string_([](std::ios&, const void *p) { return std::string(static_cast<const char*>(p)); }) {}
+			void operator()(std::ostream& o) const { to_stream_(o, ptr_); }
+			std::string get(std::ios& ios) const { return to_string_(ios, ptr_); }
+		};
+
+		inline std::string escape_string(const std::string& s) {
+			std::string result;
+			for(const char c : s) {
+				switch(c) {
+				case '<': result += "&lt;"; break;
+				case '>': result += "&gt;"; break;
+				case '&': result += "&amp;"; break;
+				case '"': result += "&quot;"; break;
+				case '\'': result += "&#39;"; break;
+				default: result += c;
+				}
+			}
+			return result;
+		}
+
+		class escape {
+			streamable obj_;
+		public:
+			template<typename T> escape(const T& value) : obj_(value) {}
+			void operator()(std::ostream& out) const { out << escape_string(obj_.get(out)); }
+		};
+		inline std::ostream& operator<<(std::ostream& out, const escape& f) { f(out); return out; }
+
+		class raw {
+			streamable obj_;
+		public:
+			template<typename T> raw(const T& value) : obj_(value) {}
+			void operator()(std::ostream& out) const { obj_(out); }
+		};
+		inline std::ostream& operator<<(std::ostream& out, const raw& f) { f(out); return out; }
+
+		class urlencode {
+			streamable obj_;
+		public:
+			template<typename T> urlencode(const T& value) : obj_(value) {}
+			void operator()(std::ostream& out) const {
+				static const char hex[] = "0123456789ABCDEF";
+				for(const char c : obj_.get(out)) {
+					const unsigned char u = static_cast<unsigned char>(c);
+					if(isalnum(u) || c == '-' || c == '_' || c == '.' || c == '~')
+						out << c;
+					else
+						out << '%' << hex[u >> 4] << hex[u & 15];
+				}
+			}
+		};
+		inline std::ostream& operator<<(std::ostream& out, const urlencode& f) { f(out); return out; }
+
+		class downcase {
+			streamable obj_;
+		public:
+			template<typename T> downcase(const T& value) : obj_(value) {}
+			void operator()(std::ostream& out) const {
+				std::string s = obj_.get(out);
+				for(char& c : s)
+					c = tolower(static_cast<unsigned char>(c));
+				out << s;
+			}
+		};
+		inline std::ostream& operator<<(std::ostream& out, const downcase& f) { f(out); return out; }
+	}
+
+	namespace locale {
+		// language of a locale, as the info facet of booster::locale tells it
+		template<typename Char = char>
+		class basic_info : public std::locale::facet {
+			std::string language_, country_;
+		public:
+			static std::locale::id id;
+			basic_info(const std::string& language, const std::string& country) : language_(language), country_(country) {}
+			std::string language() const { return language_; }
+			std::string country() const { return country_; }
+		};
+		template<typename Char>
+		std::locale::id basic_info<Char>::id;
+		typedef basic_info<> info;
+
+		// stub only: translations of the single catalog, looked up on every output as cppcms does
+		inline std::map<std::string, std::string>& catalog() {
+			static std::map<std::string, std::string> messages;
+			return messages;
+		}
+
+		class message {
+			const char *singular_, *plural_;
+			long long n_;
+		public:
+			explicit message(const char *singular, const char *plural = nullptr, long long n = 1)
+				: singular_(singular), plural_(plural), n_(n) {}
+			std::string str(const std::locale& = std::locale()) const {
+				const std::string id = (plural_ && n_ != 1) ? plural_ : singular_;
+				auto i = catalog().find(id);
+				return i == catalog().end() ? id : i->second;
+			}
+		};
+		inline std::ostream& operator<<(std::ostream& out, const message& m) { return out << m.str(out.getloc()); }
+
+		inline message translate(const char *msg) { return message(msg); }
+		inline message translate(const char *singular, const char *plural, long long n) { return message(singular, plural, n); }
+
+		// replaces {1}, {2} ... with arguments
+		class format {
+			std::string format_;
+			std::vector<std::string> args_;
+		public:
+			explicit format(const message& m) : format_(m.str()) {}
+			explicit format(const std::string& f) : format_(f) {}
+			template<typename T>
+			format& operator%(const T& value) {
+				std::ostringstream ss;
+				ss << value;
+				args_.push_back(ss.str());
+				return *this;
+			}
+			void write(std::ostream& out) const {
+				for(size_t i = 0; i < format_.size(); ++i) {
+					size_t end;
+					if(format_[i] == '{' && (end = format_.find('}', i)) != std::string::npos) {
+						const size_t n = atoi(format_.c_str() + i + 1);
+						if(n >= 1 && n <= args_.size())
+							out << args_[n - 1];
+						i = end;
+					} else {
+						out << format_[i];
+					}
+				}
+			}
+		};
+		inline std::ostream& operator<<(std::ostream& out, const format& f) { f.write(out); return out; }
+	}
+
+	namespace views {
+		class generator {
+		public:
+			struct entry_t {
+				std::string view;
+				std::type_index content;
+				std::function<std::unique_ptr<base_view>(std::ostream&, base_content&)> create;
+			};
+			void name(const std::string& name) { name_ = name; }
+			const std::string& name() const { return name_; }
+			template<typename View, typename Content>
+			void add_view(const std::string& view, bool = true) {
+				entries_.push_back(entry_t { view, std::type_index(typeid(Content)), [](std::ostream& out, base_content& content) {
+					return std::unique_ptr<base_view>(new View(out, dynamic_cast<Content&>(content)));
+				} });
+			}
+			const std::vector<entry_t>& entries() const { return entries_; }
+		private:
+			std::string name_;
+			std::vector<entry_t> entries_;
+		};
+
+		class pool {
+			std::vector<generator*> generators_;
+		public:
+			static pool& instance() { static pool p; return p; }
+			void add(generator& g) { generators_.push_back(&g); }
+			void remove(generator& g) {
+				for(auto i = generators_.begin(); i != generators_.end(); ++i) {
+					if(*i == &g) {
+						generators_.erase(i);
+						return;
+					}
+				}
+			}
+			void render(const std::string& skin, const std::string& view, std::ostream& out, base_content& content) {
+				for(generator *g : generators_) {
+					if(g->name() != skin)
+						continue;
+					for(const generator::entry_t& e : g->entries()) {
+						if(e.view == view) {
+							e.create(out, content)->render();
+							return;
+						}
+					}
+				}
+				throw std::runtime_error("no view " + skin + "::" + view);
+			}
+			// stub only: registered generators, for the benchmark harness
+			const std::vector<generator*>& generators() const { return generators_; }
+		};
+	}
+}
+#endif
@@ -0,0 +1,82 @@
+#ifndef CPPCMS_TEMPLATE_BENCH_MAGIC_DATA_H
+#define CPPCMS_TEMPLATE_BENCH_MAGIC_DATA_H
+// content types that let the tests-magic templates compile against the stub;
+// the members only have to exist, most of them are never rendered
+#include "cppcms_stub.h"
+#include <map>
+#include <string>
+#include <vector>
+
+struct blahblah {
+	template<typename... Args>
+	std::string operator()(const Args&...) const { return "blahblah"; }
+};
+
+struct person_t {
+	std::string name;
+	int age;
+};
+
+template<typename T>
+struct numeric {
+	T value;
+};
+
+namespace data {
+	struct list_t {};
+
+	struct master : public cppcms::base_content {
+		struct foo_t {
+			std::string name = "Foo & Bar";
+			int first = 1;
+			double second = 2.5;
+			template<typename... Args>
+			std::string operator()(const Args&...) const { return "foo"; }
+		} foo;
+		struct item_t {
+			std::string name;
+			double price;
+		} item_value = { "tea", 3.5 }, *item = &item_value;
+		struct oof_t {
+			std::string operator[](double) const { return "oof"; }
+		};
+		struct baz_t {
+			oof_t oof;
+		};
+		struct array_t {
+			std::vector<baz_t> baz = std::vector<baz_t>(4);
+		} array_value;
+		struct array_fn_t {
+			array_t *target;
+			array_t *operator()() const { return target; }
+		};
+		struct foobar_t {
+			std::map<std::string, array_fn_t> array;
+		} foobar;
+		struct cart_t {
+			double delivery_price(int) const { return 9.99; }
+		} cart_;
+		struct a_t {
+			bool x = true;
+		} a;
+		struct b_t {
+			bool valid() const { return true; }
+			explicit operator bool() const { return true; }
+		} b;
+		struct d_t {
+			bool valid() const { return false; }
+			bool empty() const { return true; }
+		} d;
+		std::string money(double v) const { return std::to_string(v); }
+		std::vector<item_t> container = std::vector<item_t>(10, item_value);
+		std::string ma = "ma", koty = "koty";
+		double z = 0.5;
+		bool c = false;
+		int dm = 1;
+
+		master() { foobar.array["blahblah"] = array_fn_t { &array_value }; }
+		master(const master&) = delete;
+		master& operator=(const master&) = delete;
+	};
+}
+#endif
@@ -0,0 +1,21 @@
+#ifndef CPPCMS_TMPL_RUNTIME_CACHE_H
+#define CPPCMS_TMPL_RUNTIME_CACHE_H
+// Fragment cache blocks (<% cache %>) generated with --fast-cache: frames are fetched into a buffer
+// of the rendering thread, which keeps its capacity from one hit to the next, and written to the
+// output unformatted; a miss stores its frame with a shared empty trigger set.
+#include <set>
+#include <string>
+
+namespace cppcms_tmpl {
+	// a hit writes the frame out before anything else can fetch into it, so nested cache blocks share it
+	inline std::string& frame_buffer() {
+		thread_local std::string buffer;
+		return buffer;
+	}
+
+	inline const std::set<std::string>& no_triggers() {
+		static const std::set<std::string> triggers;
+		return triggers;
+	}
+}
+#endif
@@ -0,0 +1,48 @@
+#ifndef CPPCMS_TMPL_RUNTIME_CATALOG_H
+#define CPPCMS_TMPL_RUNTIME_CATALOG_H
+// Translations baked into code generated with --locale-catalog LANGUAGE=FILE.mo: every gt / ngt call
+// site has a table of its translations in the languages of the given catalogs, picked by the language
+// of the output stream; streams in other languages are translated at runtime as usual.
+#include <cstddef>
+#include <cstring>
+#include <locale>
+#include <ostream>
+#include <string>
+
+namespace cppcms_tmpl {
+	struct catalog_text {
+		const char *text;
+		size_t length;
+	};
+
+	// index of the language of out in languages ("de\0fr_CA\0" matches "de" or "fr" with country "CA"),
+	// -1 when it is not there; Info is the locale information facet, cppcms::locale::info. The language
+	// is found once per locale and thread.
+	template<typename Info>
+	int catalog_language(std::ostream& out, const char *languages) {
+		thread_local bool known = false;
+		thread_local std::locale last;
+		thread_local std::string language, name;
+		const std::locale loc = out.getloc();
+		if(!known || !(loc == last)) {
+			known = true;
+			last = loc;
+			language.clear();
+			name.clear();
+			if(std::has_facet<Info>(loc)) {
+				const Info& info = std::use_facet<Info>(loc);
+				language = info.language();
+				name = language + "_" + info.country();
+			}
+		}
+		if(language.empty())
+			return -1;
+		int index = 0;
+		for(const char *l = languages; *l; l += strlen(l) + 1, ++index) {
+			if(language == l || name == l)
+				return index;
+		}
+		return -1;
+	}
+}
+#endif
@@ -0,0 +1,98 @@
+#ifndef CPPCMS_TMPL_RUNTIME_ESCAPE_H
+#define CPPCMS_TMPL_RUNTIME_ESCAPE_H
+// HTML escaping written straight to the output stream, used by code generated with --fast-escape
+// instead of out() << cppcms::filters::escape(x). Strings are scanned for <>&"' 32 (AVX2) or
+// 16 (SSE2) bytes at a time and written in runs, text without special characters is one write().
+// Escapes the same characters to the same entities as cppcms::util::escape.
+#include <cstring>
+#include <ostream>
+#include <sstream>
+#include <string>
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace cppcms_tmpl {
+	namespace detail {
+		inline bool special(char c) {
+			return c == '<' || c == '>' || c == '&' || c == '"' || c == '\'';
+		}
+
+		// first character of [p, end) that has to be escaped, end if none
+		inline const char *find_special(const char *p, const char *end) {
+#if defined(__AVX2__)
+			const __m256i lt = _mm256_set1_epi8('<'), gt = _mm256_set1_epi8('>'), amp = _mm256_set1_epi8('&'),
+				quot = _mm256_set1_epi8('"'), apos = _mm256_set1_epi8('\'');
+			for(; end - p >= 32; p += 32) {
+				const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+				const __m256i m = _mm256_or_si256(
+					_mm256_or_si256(_mm256_cmpeq_epi8(v, lt), _mm256_cmpeq_epi8(v, gt)),
+					_mm256_or_si256(_mm256_cmpeq_epi8(v, amp), _mm256_or_si256(_mm256_cmpeq_epi8(v, quot), _mm256_cmpeq_epi8(v, apos))));
+				if(const unsigned bits = static_cast<unsigned>(_mm256_movemask_epi8(m)))
+					return p + __builtin_ctz(bits);
+			}
+#endif
+#if defined(__SSE2__)
+			const __m128i lt16 = _mm_set1_epi8('<'), gt16 = _mm_set1_epi8('>'), amp16 = _mm_set1_epi8('&'),
+				quot16 = _mm_set1_epi8('"'), apos16 = _mm_set1_epi8('\'');
+			for(; end - p >= 16; p += 16) {
+				const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+				const __m128i m = _mm_or_si128(
+					_mm_or_si128(_mm_cmpeq_epi8(v, lt16), _mm_cmpeq_epi8(v, gt16)),
+					_mm_or_si128(_mm_cmpeq_epi8(v, amp16), _mm_or_si128(_mm_cmpeq_epi8(v, quot16), _mm_cmpeq_epi8(v, apos16))));
+				if(const unsigned bits = static_cast<unsigned>(_mm_movemask_epi8(m)))
+					return p + __builtin_ctz(bits);
+			}
+#endif
+			while(p != end && !special(*p))
+				++p;
+			return p;
+		}
+
+		inline void write_entity(std::ostream& out, char c) {
+			switch(c) {
+			case '<': out.write("&lt;", 4); break;
+			case '>': out.write("&gt;", 4); break;
+			case '&': out.write("&amp;", 5); break;
+			case '"': out.write("&quot;", 6); break;
+			default: out.write("&#39;", 5); break;
+			}
+		}
+	}
+
+	inline void escape(std::ostream& out, const char *s, size_t n) {
+		const char *const end = s + n;
+		for(;;) {
+			const char *p = detail::find_special(s, end);
+			if(p != s)
+				out.write(s, p - s);
+			if(p == end)
+				return;
+			detail::write_entity(out, *p);
+			s = p + 1;
+		}
+	}
+
+	inline void escape(std::ostream& out, const std::string& s) {
+		escape(out, s.data(), s.size());
+	}
+
+	inline void escape(std::ostream& out, const char *s) {
+		escape(out, s, strlen(s));
+	}
+
+	inline void escape(std::ostream& out, char *s) {
+		escape(out, s, strlen(s));
+	}
+
+	// anything else is formatted as cppcms::filters::escape does: with the format state (flags, precision,
+	// locale...) of the output stream
+	template<typename T>
+	void escape(std::ostream& out, const T& value) {
+		std::ostringstream ss;
+		ss.copyfmt(out);
+		ss << value;
+		escape(out, ss.str());
+	}
+}
+#endif
@@ -0,0 +1,78 @@
+#ifndef CPPCMS_TMPL_RUNTIME_FORMAT_H
+#define CPPCMS_TMPL_RUNTIME_FORMAT_H
+// Arguments of <% format %> / <% rformat %> strings parsed by cppcms_tmpl_ccpp (--compile-format):
+// the literal text is written as is and every argument straight to the output stream buffer in the state
+// boost::format would have formatted it in, without building a std::string per call.
+#include <locale>
+#include <ostream>
+#include <streambuf>
+#include "escape.h"
+
+namespace cppcms_tmpl {
+	namespace detail {
+		// stream the arguments are formatted with, one per thread pointed at the buffer written to, so the
+		// output stream is left as is; it has the global locale, as boost::format does not use the locale of
+		// the stream it is written to
+		inline std::ostream& format_stream(std::streambuf *buf) {
+			thread_local std::ostream stream(nullptr);
+			const std::locale global;
+			if(!(stream.getloc() == global))
+				stream.imbue(global);
+			stream.rdbuf(buf);
+			return stream;
+		}
+
+		// value written to buf in the state of its directive, failures are reported on out
+		template<typename T>
+		void format_to(std::ostream& out, std::streambuf *buf, const T& value, std::ios_base::fmtflags flags,
+				std::streamsize width, std::streamsize precision, char fill)
+		{
+			std::ostream& s = format_stream(buf);
+			s.flags(flags);
+			s.width(width);
+			s.precision(precision);
+			s.fill(fill);
+			s << value;
+			if(!s)
+				out.setstate(std::ios_base::badbit);
+			s.rdbuf(nullptr);
+		}
+
+		// html escapes everything written through it into another stream
+		class escape_buf : public std::streambuf {
+		public:
+			explicit escape_buf(std::ostream& out) : out_(out) {}
+		protected:
+			int_type overflow(int_type c) override {
+				if(traits_type::eq_int_type(c, traits_type::eof()))
+					return traits_type::not_eof(c);
+				const char ch = traits_type::to_char_type(c);
+				return put(&ch, 1) ? c : traits_type::eof();
+			}
+			std::streamsize xsputn(const char *s, std::streamsize n) override {
+				return put(s, n) ? n : 0;
+			}
+		private:
+			bool put(const char *s, std::streamsize n) {
+				cppcms_tmpl::escape(out_, s, n);
+				return out_.good();
+			}
+			std::ostream& out_;
+		};
+	}
+
+	// one argument, written with the flags, width, precision and fill of its directive; html escaped
+	// when escape is set (<% format %>), with the global locale either way, as boost::format does
+	template<typename T>
+	void format_arg(std::ostream& out, const T& value, bool escape, std::ios_base::fmtflags flags,
+			std::streamsize width = 0, std::streamsize precision = 6, char fill = ' ')
+	{
+		if(!escape) {
+			detail::format_to(out, out.rdbuf(), value, flags, width, precision, fill);
+			return;
+		}
+		detail::escape_buf escaped(out);
+		detail::format_to(out, &escaped, value, flags, width, precision, fill);
+	}
+}
+#endif
@@ -0,0 +1,126 @@
+#ifndef CPPCMS_TMPL_RUNTIME_TRANSLATE_H
+#define CPPCMS_TMPL_RUNTIME_TRANSLATE_H
+// Translations of one <% gt %> / <% ngt %> call site, used by code generated with --cache-gt: the
+// catalog is searched once per locale and plural form instead of on every render, then the translated
+// string is written as is. Every locale has the texts of the forms met so far and, for counts below
+// translation_cache::counts, the form of each count; other counts, and locales past the first
+// translation_cache::locales, are translated on every render.
+// Shared by all threads rendering the call site, which read it without locking; the message domain
+// is the one of the stream at the first lookup, a call site is expected to keep its domain.
+#include <atomic>
+#include <locale>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+namespace cppcms_tmpl {
+	class translation_cache {
+	public:
+		static const int counts = 128; // counts 0..counts-1 remember their form
+		static const int forms = 8; // distinct texts per locale, gettext catalogs have up to 6 forms
+		static const int locales = 32;
+
+		translation_cache() : head_(nullptr), size_(0) {}
+		translation_cache(const translation_cache&) = delete;
+		translation_cache& operator=(const translation_cache&) = delete;
+		~translation_cache() {
+			for(const entry_t *e = head_.load(), *next; e; e = next) {
+				next = e->next;
+				delete e;
+			}
+		}
+
+		// message translated as out would write it, n is the count of ngt (anything constant for gt);
+		// valid until the next call on this thread for counts that are not cached
+		template<typename Message>
+		const std::string& get(std::ostream& out, long long n, const Message& message) {
+			thread_local std::string uncached;
+			entry_t *e = n < 0 || n >= counts ? nullptr : entry(out.getloc());
+			if(!e) {
+				uncached = translate(out, message);
+				return uncached;
+			}
+			const int form = e->form[n].load(std::memory_order_acquire);
+			if(form != unknown)
+				return *e->text[form].load(std::memory_order_acquire);
+			// looked up outside of the lock, another thread may store the same form meanwhile
+			const std::string text = translate(out, message);
+			std::lock_guard<std::mutex> guard(lock_);
+			int i = 0;
+			for(const std::string *t; i < forms && (t = e->text[i].load(std::memory_order_relaxed)); ++i) {
+				if(*t == text)
+					break;
+			}
+			if(i == forms) {
+				uncached = text;
+				return uncached;
+			}
+			if(!e->text[i].load(std::memory_order_relaxed))
+				e->text[i].store(new std::string(text), std::memory_order_release);
+			e->form[n].store(static_cast<signed char>(i), std::memory_order_release);
+			return *e->text[i].load(std::memory_order_relaxed);
+		}
+
+		template<typename Message>
+		void write(std::ostream& out, long long n, const Message& message) {
+			const std::string& text = get(out, n, message);
+			out.write(text.data(), text.size());
+		}
+	private:
+		static const int unknown = -1;
+
+		struct entry_t {
+			explicit entry_t(const std::locale& l) : loc(l), next(nullptr) {
+				for(std::atomic<signed char>& f : form)
+					f.store(unknown, std::memory_order_relaxed);
+				for(std::atomic<const std::string*>& t : text)
+					t.store(nullptr, std::memory_order_relaxed);
+			}
+			~entry_t() {
+				for(std::atomic<const std::string*>& t : text)
+					delete t.load();
+			}
+			const std::locale loc; // compared by identity, or by name for named locales
+			std::atomic<signed char> form[counts]; // index in text of the form of each count
+			std::atomic<const std::string*> text[forms];
+			entry_t *next;
+		};
+
+		template<typename Message>
+		static std::string translate(std::ostream& out, const Message& message) {
+			std::ostringstream ss;
+			ss.copyfmt(out); // locale and message domain
+			ss.width(0);
+			ss << message;
+			return ss.str();
+		}
+
+		// entries are only ever prepended, so readers walk the list without locking;
+		// nullptr once there are as many entries as locales
+		entry_t *entry(const std::locale& loc) {
+			entry_t *head = head_.load(std::memory_order_acquire);
+			for(entry_t *e = head; e; e = e->next) {
+				if(e->loc == loc)
+					return e;
+			}
+			std::lock_guard<std::mutex> guard(lock_);
+			for(entry_t *e = head_.load(std::memory_order_relaxed); e != head; e = e->next) {
+				if(e->loc == loc)
+					return e;
+			}
+			if(size_ == locales)
+				return nullptr;
+			++size_;
+			entry_t *e = new entry_t(loc);
+			e->next = head_.load(std::memory_order_relaxed);
+			head_.store(e, std::memory_order_release);
+			return e;
+		}
+
+		std::mutex lock_; // taken by writers only
+		std::atomic<entry_t*> head_;
+		int size_;
+	};
+}
+#endif
@@ -0,0 +1,105 @@
+#ifndef CPPCMS_TMPL_RUNTIME_URL_H
+#define CPPCMS_TMPL_RUNTIME_URL_H
+// Mapped urls of one <% url %> call site, used by code generated with --cache-url: the url mapper
+// runs once per application instance, with placeholders for the arguments, and the result is kept as
+// static text and argument slots, filled on every render without mapping again. Every thread has its
+// own cache of the call site (static thread_local), so nothing is locked.
+// Mapper values ({lang}...) are substituted when the url is mapped: they must be changed through
+// set_url_value / clear_url_value, or url_values_changed() called after changing them, which makes
+// every cached url be mapped again.
+#include <atomic>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+namespace cppcms_tmpl {
+	struct url_part {
+		std::string text;
+		int slot; // argument written after text, -1 for none
+	};
+	typedef std::vector<url_part> url_parts;
+
+	// placeholder passed to the mapper for argument i
+	inline std::string url_slot(int i) {
+		return std::string(1, '\1') + static_cast<char>('A' + i);
+	}
+
+	// changes whenever mapper values may have changed
+	inline std::atomic<unsigned>& url_generation() {
+		static std::atomic<unsigned> generation(0);
+		return generation;
+	}
+
+	inline void url_values_changed() {
+		url_generation().fetch_add(1, std::memory_order_acq_rel);
+	}
+
+	// cppcms::url_mapper::set_value / clear_value for applications compiled with --cache-url
+	template<typename Mapper>
+	void set_url_value(Mapper& mapper, const std::string& key, const std::string& value) {
+		mapper.set_value(key, value);
+		url_values_changed();
+	}
+
+	template<typename Mapper>
+	void clear_url_value(Mapper& mapper, const std::string& key) {
+		mapper.clear_value(key);
+		url_values_changed();
+	}
+
+	class url_cache {
+	public:
+		url_cache() {}
+		url_cache(const url_cache&) = delete;
+		url_cache& operator=(const url_cache&) = delete;
+
+		// url of the application (its mapper and class, so that an application created where a
+		// destroyed one was is only taken for it when it is of the same class) split at the argument
+		// slots; map(std::ostream&) writes it with url_slot() arguments. Valid until the next call.
+		template<typename Map>
+		const url_parts& get(const void *mapper, const std::type_info& app, Map map) {
+			const unsigned generation = url_generation().load(std::memory_order_acquire);
+			entry_t *e = nullptr;
+			for(entry_t& candidate : entries_) {
+				if(candidate.mapper == mapper && *candidate.app == app) {
+					e = &candidate;
+					break;
+				}
+			}
+			if(e && e->generation == generation)
+				return e->parts;
+			if(!e) {
+				entries_.push_back(entry_t { mapper, &app, generation, url_parts() });
+				e = &entries_.back();
+			}
+			e->generation = generation;
+			e->parts.clear();
+			std::ostringstream ss;
+			map(ss);
+			const std::string url = ss.str();
+			size_t begin = 0;
+			for(size_t p; (p = url.find('\1', begin)) != std::string::npos && p + 1 < url.size(); begin = p + 2)
+				e->parts.push_back(url_part { url.substr(begin, p - begin), url[p + 1] - 'A' });
+			e->parts.push_back(url_part { url.substr(begin), -1 });
+			return e->parts;
+		}
+
+		// url without arguments
+		template<typename Map>
+		void write(std::ostream& out, const void *mapper, const std::type_info& app, Map map) {
+			for(const url_part& p : get(mapper, app, map))
+				out.write(p.text.data(), p.text.size());
+		}
+	private:
+		struct entry_t {
+			const void *mapper;
+			const std::type_info *app;
+			unsigned generation;
+			url_parts parts;
+		};
+		std::vector<entry_t> entries_; // applications rendered by this thread
+	};
+}
+#endif
@@ -0,0 +1,157 @@
+#include "alloc_stats.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <cxxabi.h>
+
+namespace cppcms { namespace templates { namespace alloc_stats {
+	namespace {
+		struct counters_t {
+			const char *label;
+			size_t count, bytes, live, peak;
+		};
+
+		struct header_t {
+			size_t size;
+			int16_t slot[2]; // phase, node
+		};
+		static const size_t header_size = 16;
+		static_assert(sizeof(header_t) <= header_size, "header does not fit");
+
+		// plain static storage, usable before and after any constructor/destructor runs
+		const int max_slots = 256;
+		counters_t slots[2][max_slots];
+		int used[2];
+		int current[2] = { -1, -1 };
+		size_t live, peak, total_count, total_bytes;
+		std::mutex lock;
+
+		void account(counters_t& c, size_t size) {
+			c.count++;
+			c.bytes += size;
+			c.live += size;
+			if(c.live > c.peak)
+				c.peak = c.live;
+		}
+
+		int find_slot(kind_t kind, const char *label) {
+			std::lock_guard<std::mutex> guard(lock);
+			for(int i = 0; i < used[kind]; ++i) {
+				if(slots[kind][i].label == label || strcmp(slots[kind][i].label, label) == 0)
+					return i;
+			}
+			if(used[kind] == max_slots)
+				return -1;
+			slots[kind][used[kind]].label = label;
+			return used[kind]++;
+		}
+
+		void *allocate(size_t size) {
+			char *p = static_cast<char*>(malloc(size + header_size));
+			if(!p)
+				return nullptr;
+			header_t *h = reinterpret_cast<header_t*>(p);
+			h->size = size;
+			std::lock_guard<std::mutex> guard(lock);
+			for(int k = 0; k < 2; ++k) {
+				h->slot[k] = current[k];
+				if(current[k] >= 0)
+					account(slots[k][current[k]], size);
+			}
+			total_count++;
+			total_bytes += size;
+			live += size;
+			if(live > peak)
+				peak = live;
+			return p + header_size;
+		}
+
+		void deallocate(void *ptr) {
+			if(!ptr)
+				return;
+			char *p = static_cast<char*>(ptr) - header_size;
+			const header_t *h = reinterpret_cast<const header_t*>(p);
+			{
+				std::lock_guard<std::mutex> guard(lock);
+				for(int k = 0; k < 2; ++k) {
+					if(h->slot[k] >= 0)
+						slots[k][h->slot[k]].live -= h->size;
+				}
+				live -= h->size;
+			}
+			free(p);
+		}
+
+		void print(kind_t kind, const char *title) {
+			if(used[kind] == 0)
+				return;
+			fprintf(stderr, "%-40s %10s %12s %12s %12s\n", title, "count", "bytes", "live", "peak live");
+			for(int i = 0; i < used[kind]; ++i) {
+				const counters_t& c = slots[kind][i];
+				int status = 0;
+				char *demangled = kind == node ? abi::__cxa_demangle(c.label, nullptr, nullptr, &status) : nullptr;
+				fprintf(stderr, "%-40s %10zu %12zu %12zu %12zu\n", demangled ? demangled : c.label, c.count, c.bytes, c.live, c.peak);
+				free(demangled);
+			}
+		}
+
+		struct reporter_t {
+			~reporter_t() {
+				fprintf(stderr, "allocations: %zu, bytes: %zu, peak live: %zu, live at exit: %zu\n", total_count, total_bytes, peak, live);
+				print(phase, "phase");
+				print(node, "AST node (allocated while constructing)");
+			}
+		} reporter;
+	}
+
+	scope::scope(kind_t kind, const char *label)
+		: kind_(kind)
+		, previous_(current[kind]) {
+		const int slot = find_slot(kind, label);
+		std::lock_guard<std::mutex> guard(lock);
+		current[kind] = slot;
+	}
+
+	scope::~scope() {
+		std::lock_guard<std::mutex> guard(lock);
+		current[kind_] = previous_;
+	}
+}}}
+
+void *operator new(size_t size) {
+	void *p = cppcms::templates::alloc_stats::allocate(size);
+	if(!p)
+		throw std::bad_alloc();
+	return p;
+}
+
+void *operator new[](size_t size) {
+	return operator new(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t&) noexcept {
+	return cppcms::templates::alloc_stats::allocate(size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t&) noexcept {
+	return cppcms::templates::alloc_stats::allocate(size);
+}
+
+void operator delete(void *p) noexcept {
+	cppcms::templates::alloc_stats::deallocate(p);
+}
+
+void operator delete[](void *p) noexcept {
+	cppcms::templates::alloc_stats::deallocate(p);
+}
+
+void operator delete(void *p, const std::nothrow_t&) noexcept {
+	cppcms::templates::alloc_stats::deallocate(p);
+}
+
+void operator delete[](void *p, const std::nothrow_t&) noexcept {
+	cppcms::templates::alloc_stats::deallocate(p);
+}
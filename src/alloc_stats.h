@@ -0,0 +1,25 @@
+#ifndef CPPCMS_TEMPLATE_COMPILER_ALLOC_STATS_H
+#define CPPCMS_TEMPLATE_COMPILER_ALLOC_STATS_H
+
+// allocation accounting, built with cmake -DCPPCMS_TMPL_ALLOC_STATS=ON
+// global operator new/delete are replaced and every allocation is attributed
+// to the innermost phase and AST node type scope; report is printed to stderr at exit
+namespace cppcms { namespace templates { namespace alloc_stats {
+	enum kind_t { phase, node };
+#ifdef CPPCMS_TMPL_ALLOC_STATS
+	class scope {
+		const kind_t kind_;
+		const int previous_;
+	public:
+		scope(kind_t kind, const char *label);
+		scope(const scope&) = delete;
+		~scope();
+	};
+#else
+	class scope {
+	public:
+		scope(kind_t, const char *) {}
+	};
+#endif
+}}}
+#endif
@@ -1,16 +1,33 @@
 #include "ast.h"
+#include "trace.h"
+#include "perf_lint.h"
+#include "size_report.h"
+#include "minify.h"
+#include "format_string.h"
+#include "catalog.h"
+#include "alloc_stats.h"
 #include <algorithm>
 #include <sstream>
 #include <boost/lexical_cast.hpp>
 
 namespace cppcms { namespace templates { namespace ast {
 	struct ln { 
+		generator::context& context_;
 		const file_position_t line_;
-		ln(file_position_t line) : line_(line) {}
+		ln(generator::context& context, file_position_t line) : context_(context), line_(line) {}
 	};
 	
-	static std::ostream& operator<<(std::ostream&o, const ln& obj) {
-		return o << "#line " << obj.line_.line << " \"" << obj.line_.filename << "\"\n";
+	// content accessor chain evaluated by the generated code
+	static void lint_accessor(generator::context& context, const file_position_t& line, const expr::variable& variable) {
+		if(context.linter)
+			context.linter->accessor(line, variable->repr(), context.check_scope_variable(perf_lint::linter::root(variable->repr())));
+	}
+
+	static generator::code_writer& operator<<(generator::code_writer& o, const ln& obj) {
+		// every statement is preceded by its #line
+		if(obj.context_.sizes)
+			obj.context_.sizes->line_directive();
+		return o.line(obj.line_.line, obj.context_.source_path(obj.line_.filename), obj.context_.line_mode);
 	}
 	
 
@@ -23,6 +40,14 @@ namespace cppcms { namespace templates { namespace ast {
 		return line_; 
 	}	
 	base_ptr base_t::parent() { return parent_; }
+
+	void base_t::clear() {
+		parent_.reset();
+	}
+
+	bool base_t::static_text(const generator::context&, std::vector<const text_t*>&) const {
+		return false;
+	}
 	
 	const std::string& base_t::sysname() const {
 		return sysname_;
@@ -64,6 +89,7 @@ namespace cppcms { namespace templates { namespace ast {
 			return ve.first.repr() == name->repr();
 		});
 		if(i == current_skin->second.views.end()) {
+			alloc_stats::scope s(alloc_stats::node, typeid(view_t).name());
 			current_skin->second.views.emplace_back(
 				*name, std::make_shared<view_t>(name, line, data, parent, shared_from_this())
 			);
@@ -89,7 +115,7 @@ namespace cppcms { namespace templates { namespace ast {
 		return shared_from_this();
 	}
 
-	void root_t::write(generator::context& context, std::ostream& output) {			
+	void root_t::prepare(generator::context& context) {
 		// checks
 		// check if there is at least one skin
 		if(skins.empty()) {
@@ -109,74 +135,285 @@ namespace cppcms { namespace templates { namespace ast {
 				skins.erase(i);
 			}
 		}
-
-		std::ostringstream buffer;
 		
+		for(const skins_t::value_type& skin : skins) {
+			if(!context.skin.empty() && context.skin != skin.first.repr())
+				throw error_at_line("Mismatched skin names, in argument and template source", skin.second.line);
+		}
+	}
+
+	void root_t::write_codes(generator::context& context, generator::code_writer& o) {
 		for(const code_t& code : codes) {
-			buffer << ln(code.line) << code.code->code(context) << std::endl;
+			o << ln(context, code.line) << expr::emit(context, code.code) << "\n";
+		}
+	}
+
+	void root_t::write_includes(generator::context& context, generator::code_writer& o) {
+		for(const generator::context::include_t& include : context.includes) {
+			o << "#include <" << include << ">\n";
+		}
+	}
+
+	void root_t::write_loader(generator::context& context, generator::code_writer& o) {
+		file_position_t pll = skins.rbegin()->second.endline; // past last line
+		pll.line++;
+
+		for(const auto& skinpair : context.skins) {
+			o << "\n" << ln(context, pll) << "namespace {\n" << ln(context, pll) << "cppcms::views::generator my_generator;\n" << ln(context, pll) << "struct loader {\n";
+			o << ln(context, pll) << "loader() {\n" << ln(context, pll);			
+			o << "my_generator.name(\"" << skinpair.first << "\");\n";
+			for(const auto& view : skinpair.second.views) {
+				o << ln(context, pll) << "my_generator.add_view< " << skinpair.first << "::" << view.name << ", " << view.data << " >(\"" << view.name << "\", true);\n";
+			}
+			o << ln(context, pll) << "cppcms::views::pool::instance().add(my_generator);\n";
+			o << ln(context, pll) << "}\n";
+			o << ln(context, pll) << "~loader() { cppcms::views::pool::instance().remove(my_generator); }\n";
+			o << ln(context, pll) << "} a_loader;\n";
+			o << ln(context, pll) << "} // anon \n";
+		}
+	}
+
+	void root_t::write(generator::context& context, generator::code_writer& output) {			
+		prepare(context);
+		if(context.stream) {
+			write_stream(context, output);
+			return;
 		}
+
+		generator::code_writer buffer;
+		write_codes(context, buffer);
 		
 		for(const skins_t::value_type& skin : skins) {
-			if(!context.skin.empty() && context.skin != skin.first.repr())
-				throw error_at_line("Mismatched skin names, in argument and template source", skin.second.line);
-			buffer << ln(skin.second.line);
-			buffer << "namespace " << skin.first.code(context) << " {\n";
+			buffer << ln(context, skin.second.line);
+			buffer << "namespace " << expr::emit(context, skin.first) << " {\n";
 			context.current_skin = skin.first.repr();
 			for(const view_set_t::value_type& view : skin.second.views) {
 				view.second->write(context, buffer);
 			}
-			buffer << ln(skin.second.endline);
-			buffer << "} // end of namespace " << skin.first.code(context) << "\n";
+			buffer << ln(context, skin.second.endline);
+			buffer << "} // end of namespace " << expr::emit(context, skin.first) << "\n";
 		}
-		file_position_t pll = skins.rbegin()->second.endline; // past last line
-		pll.line++;
+		write_loader(context, buffer);
+		
+		write_includes(context, output);
+		output.splice(buffer);
+	}
 
-		for(const auto& skinpair : context.skins) {
-			buffer << "\n" << ln(pll) << "namespace {\n" << ln(pll) << "cppcms::views::generator my_generator;\n" << ln(pll) << "struct loader {\n";
-			buffer << ln(pll) << "loader() {\n" << ln(pll);			
-			buffer << "my_generator.name(\"" << skinpair.first << "\");\n";
-			for(const auto& view : skinpair.second.views) {
-				buffer << ln(pll) << "my_generator.add_view< " << skinpair.first << "::" << view.name << ", " << view.data << " >(\"" << view.name << "\", true);\n";
+	void root_t::write_stream(generator::context& context, generator::code_writer& output) {
+		// every view is written as soon as it is generated and then released;
+		// includes required by a view are written just before it, outside of skin namespace
+		write_codes(context, output);
+		std::set<generator::context::include_t> written;
+		for(skins_t::value_type& skin : skins) {
+			bool open = false;
+			context.current_skin = skin.first.repr();
+			for(view_set_t::value_type& view : skin.second.views) {
+				generator::code_writer buffer;
+				view.second->write(context, buffer);
+				view.second->clear();
+				view.second.reset();
+
+				std::vector<generator::context::include_t> fresh;
+				for(const generator::context::include_t& include : context.includes) {
+					if(written.insert(include).second)
+						fresh.push_back(include);
+				}
+				if(!fresh.empty() && open) {
+					output << ln(context, skin.second.line) << "} // end of namespace " << expr::emit(context, skin.first) << "\n";
+					open = false;
+				}
+				for(const generator::context::include_t& include : fresh) {
+					output << "#include <" << include << ">\n";
+				}
+				if(!open) {
+					output << ln(context, skin.second.line) << "namespace " << expr::emit(context, skin.first) << " {\n";
+					open = true;
+				}
+				output.splice(buffer);
+				output.flush();
 			}
-			buffer << ln(pll) << "cppcms::views::pool::instance().add(my_generator);\n";
-			buffer << ln(pll) << "}\n";
-			buffer << ln(pll) << "~loader() { cppcms::views::pool::instance().remove(my_generator); }\n";
-			buffer << ln(pll) << "} a_loader;\n";
-			buffer << ln(pll) << "} // anon \n";
+			if(!open)
+				output << ln(context, skin.second.line) << "namespace " << expr::emit(context, skin.first) << " {\n";
+			output << ln(context, skin.second.endline) << "} // end of namespace " << expr::emit(context, skin.first) << "\n";
+		}
+		write_loader(context, output);
+	}
+
+	void root_t::clear() {
+		for(skins_t::value_type& skin : skins) {
+			for(view_set_t::value_type& view : skin.second.views) {
+				if(view.second)
+					view.second->clear();
+			}
+		}
+		skins.clear();
+		current_skin = skins.end();
+		base_t::clear();
+	}
+
+	void root_t::write_units(generator::context& context, std::vector<generator::unit_t>& units) {
+		prepare(context);
+
+		// header: includes, global c++ codes and class declarations of all views
+		generator::code_writer global, header;
+		write_codes(context, global);
+		std::vector< std::pair<skins_t::const_iterator, view_ptr> > views;
+		for(auto skin = skins.cbegin(); skin != skins.cend(); ++skin) {
+			header << ln(context, skin->second.line);
+			header << "namespace " << expr::emit(context, skin->first) << " {\n";
+			context.current_skin = skin->first.repr();
+			for(const view_set_t::value_type& view : skin->second.views) {
+				view.second->write_declaration(context, header);
+				views.emplace_back(skin, view.second);
+			}
+			header << ln(context, skin->second.endline);
+			header << "} // end of namespace " << expr::emit(context, skin->first) << "\n";
 		}
 		
-		for(const generator::context::include_t& include : context.includes) {
-			output << "#include <" << include << ">\n";
+		const std::string header_name = "views.h", prelude_name = "prelude.h";
+		generator::code_writer header_unit;
+		header_unit << "#ifndef CPPCMS_GENERATED_VIEWS_H\n#define CPPCMS_GENERATED_VIEWS_H\n";
+		if(context.prelude) {
+			header_unit << "#include \"" << prelude_name << "\"\n";
+		} else {
+			write_includes(context, header_unit);
+			header_unit.splice(global);
+		}
+		header_unit.splice(header);
+		header_unit << "#endif\n";
+		units.push_back(generator::unit_t { header_name, header_unit.str() });
+
+		// shards: out of line definitions of view templates, each shard with its own includes,
+		// or with a prelude the union of them all goes to prelude.h
+		std::set<generator::context::include_t> includes = context.includes;
+		std::vector<generator::unit_t> shard_units;
+		// no more shards than views, so that none is empty
+		const size_t shards = (context.shards > 0 ? std::min(context.shards, views.size()) : views.size());
+		for(size_t shard = 0; shard < shards; ++shard) {
+			context.includes.clear();
+			generator::code_writer buffer;
+			skins_t::const_iterator current = skins.cend();
+			for(size_t i = 0; i < views.size(); ++i) {
+				if(i * shards / views.size() != shard) 
+					continue;
+				if(current != views[i].first) {
+					if(current != skins.cend())
+						buffer << ln(context, current->second.endline) << "} // end of namespace " << expr::emit(context, current->first) << "\n";
+					current = views[i].first;
+					buffer << ln(context, current->second.line) << "namespace " << expr::emit(context, current->first) << " {\n";
+					context.current_skin = current->first.repr();
+				}
+				views[i].second->write_definitions(context, buffer);
+			}
+			if(current != skins.cend())
+				buffer << ln(context, current->second.endline) << "} // end of namespace " << expr::emit(context, current->first) << "\n";
+			
+			generator::code_writer unit;
+			if(context.prelude) {
+				// the prelude comes first, so it can be replaced by a precompiled header
+				unit << "#include \"" << prelude_name << "\"\n#include \"" << header_name << "\"\n";
+				includes.insert(context.includes.begin(), context.includes.end());
+			} else {
+				unit << "#include \"" << header_name << "\"\n";
+				write_includes(context, unit);
+			}
+			unit.splice(buffer);
+			shard_units.push_back(generator::unit_t { "views_" + boost::lexical_cast<std::string>(shard) + ".cpp", unit.str() });
 		}
-		output << buffer.str();
+
+		// prelude: every include and global c++ code, the only headers a unit parses besides views.h
+		if(context.prelude) {
+			context.includes = includes;
+			generator::code_writer prelude;
+			prelude << "#ifndef CPPCMS_GENERATED_PRELUDE_H\n#define CPPCMS_GENERATED_PRELUDE_H\n";
+			write_includes(context, prelude);
+			prelude.splice(global);
+			prelude << "#endif\n";
+			units.push_back(generator::unit_t { prelude_name, prelude.str() });
+		}
+		for(generator::unit_t& unit : shard_units)
+			units.push_back(std::move(unit));
+
+		// loader: registration of all views in cppcms::views::pool
+		generator::code_writer loader;
+		if(context.prelude)
+			loader << "#include \"" << prelude_name << "\"\n";
+		loader << "#include \"" << header_name << "\"\n";
+		write_loader(context, loader);
+		units.push_back(generator::unit_t { "loader.cpp", loader.str() });
 	}
 	
-	void view_t::write(generator::context& context, std::ostream& o) {
+	void view_t::write_head(generator::context& context, generator::code_writer& o) {
 		context.skins[context.current_skin].views.emplace_back( generator::context::view_t { name_->code(context), data_->code(context) });
-		o << ln(line());
-		o << "struct " << name_->code(context) << ":public ";
+		o << ln(context, line());
+		o << "struct " << expr::emit(context, name_) << ":public ";
 		if(master_)
-			o << master_->code(context) << "\n";
+			o << expr::emit(context, master_) << "\n";
 		else
 			o << "cppcms::base_view\n";
-		o << ln(line()) << " {\n";
+		o << ln(context, line()) << " {\n";
 		
-		o << ln(line());
-		o << data_->code(context) << " & content;\n";
+		o << ln(context, line());
+		o << expr::emit(context, data_) << " & content;\n";
 		
-		o << ln(line());
-		o << name_->code(context) << "(std::ostream & _s, " << data_->code(context) << " & _content):";
+		o << ln(context, line());
+		o << expr::emit(context, name_) << "(std::ostream & _s, " << expr::emit(context, data_) << " & _content):";
 		if(master_)
-			o << master_->code(context) << "(_s, _content)";
+			o << expr::emit(context, master_) << "(_s, _content)";
 		else 
 			o << "cppcms::base_view(_s)";
-		o << ",content(_content)\n" << ln(line()) << "{\n" << ln(line()) << "}\n";
+		o << ",content(_content)\n" << ln(context, line()) << "{\n" << ln(context, line()) << "}\n";
+	}
 
+	void view_t::write(generator::context& context, generator::code_writer& o) {
+		trace::scope s(context.tracer, context.current_skin + "::" + name_->repr(), "view");
+		const size_t size = o.size();
+		if(context.sizes)
+			context.sizes->begin_view(context.current_skin, name_->code(context), line());
+		write_head(context, o);
 		for(const templates_t::value_type& tpl : templates) {
 			tpl.second->write(context, o);
 		}
 
-		o << ln(endline_) << "}; // end of class " << name_->code(context) << "\n";
+		o << ln(context, endline_) << "}; // end of class " << expr::emit(context, name_) << "\n";
+		if(context.sizes)
+			context.sizes->end_view(o.size() - size);
+		s.arg("bytes", o.size() - size);
+	}
+	
+	void view_t::write_declaration(generator::context& context, generator::code_writer& o) {
+		const size_t size = o.size();
+		if(context.sizes)
+			context.sizes->begin_view(context.current_skin, name_->code(context), line());
+		write_head(context, o);
+		for(const templates_t::value_type& tpl : templates) {
+			tpl.second->write_declaration(context, o);
+		}
+
+		o << ln(context, endline_) << "}; // end of class " << expr::emit(context, name_) << "\n";
+		if(context.sizes)
+			context.sizes->end_view(o.size() - size);
+	}
+	
+	void view_t::write_definitions(generator::context& context, generator::code_writer& o) {
+		trace::scope s(context.tracer, context.current_skin + "::" + name_->repr(), "view");
+		const size_t size = o.size();
+		if(context.sizes)
+			context.sizes->begin_view(context.current_skin, name_->code(context), line());
+		for(const templates_t::value_type& tpl : templates) {
+			tpl.second->write_definition(context, o, name_->code(context));
+		}
+		if(context.sizes)
+			context.sizes->end_view(o.size() - size);
+		s.arg("bytes", o.size() - size);
+	}
+
+	void view_t::clear() {
+		for(const templates_t::value_type& tpl : templates) {
+			tpl.second->clear();
+		}
+		templates.clear();
+		base_t::clear();
 	}
 		
 	void root_t::dump(std::ostream& o, int tabs)  const {
@@ -204,8 +441,53 @@ namespace cppcms { namespace templates { namespace ast {
 		o << p << "text: " << *value_ << std::endl;			
 	}
 
-	void text_t::write(generator::context& context, std::ostream& o) {
-		o << ln(line()) << "out() << " << value_->code(context) << ";\n";
+	bool text_t::markup() const {
+		return value_->is_a<expr::html_t>() || value_->is_a<expr::xhtml_t>();
+	}
+
+	void text_t::write(generator::context& context, generator::code_writer& o) {
+		expr::ptr value = value_;
+		if(context.minifier && markup()) {
+			value = expr::make_text(context.minifier->text(value_->as<expr::text_t>().unescaped()));
+			if(value->as<expr::text_t>().escaped().empty())
+				return;
+		}
+		if(context.sizes)
+			context.sizes->literal(value->as<expr::text_t>().length());
+		o << ln(context, line()) << context.out_stream() << " << " << expr::emit(context, value) << ";\n";
+	}
+
+	bool text_t::static_text(const generator::context&, std::vector<const text_t*>& texts) const {
+		texts.push_back(this);
+		return true;
+	}
+
+	void text_t::write_run(generator::context& context, generator::code_writer& o, const std::vector<const text_t*>& texts) {
+		// no strlen() and no formatting at render time
+		if(texts.empty())
+			return;
+		std::string escaped;
+		size_t length = 0;
+		if(context.minifier && texts.front()->markup()) {
+			// the whole run at once, so whitespace is collapsed across nodes
+			std::string html;
+			for(const text_t *t : texts)
+				html += t->value_->as<expr::text_t>().unescaped();
+			const expr::text value = expr::make_text(context.minifier->text(html));
+			escaped = value->escaped();
+			length = value->length();
+		} else {
+			for(const text_t *t : texts) {
+				const expr::text_t& value = t->value_->as<expr::text_t>();
+				escaped += value.escaped();
+				length += value.length();
+			}
+		}
+		if(escaped.empty())
+			return;
+		o << ln(context, texts.front()->line()) << context.out_stream() << ".write(\"" << escaped << "\", " << length << ");\n";
+		if(context.sizes)
+			context.sizes->literal(length);
 	}
 	base_ptr text_t::end(const std::string&, file_position_t) {
 		throw std::logic_error("unreachable code -- this is not block node");			
@@ -221,33 +503,76 @@ namespace cppcms { namespace templates { namespace ast {
 		}
 	}
 
-	void template_t::write(generator::context& context, std::ostream& o) {
+	void template_t::write(generator::context& context, generator::code_writer& o) {
 		if(!template_arguments_.empty()) {
-			o << ln(line()) << "template<";
+			o << ln(context, line()) << "template<";
 			for(auto i = template_arguments_.begin(); i != template_arguments_.end(); ++i) {
 				const expr::identifier& x = *i;
 				if(i != template_arguments_.begin()) 
 					o << ", ";
-				o << "typename " << x->code(context);
+				o << "typename " << expr::emit(context, x);
 			}
-			o << ">\n" << ln(line()) << "void " << name_->code(context) << arguments_->code(context) << "{\n";
+			o << ">\n" << ln(context, line()) << "void " << expr::emit(context, name_) << expr::emit(context, arguments_) << "{\n";
 		} else {
-			o << ln(line()) << "virtual void " << name_->code(context) << arguments_->code(context) << "{\n";
+			o << ln(context, line()) << "virtual void " << expr::emit(context, name_) << expr::emit(context, arguments_) << "{\n";
 		}
+		write_body(context, o);
+	}
+
+	void template_t::write_declaration(generator::context& context, generator::code_writer& o) {
+		// generic templates can not be defined out of class
+		if(!template_arguments_.empty()) {
+			write(context, o);
+		} else {
+			o << ln(context, line()) << "virtual void " << expr::emit(context, name_) << expr::emit(context, arguments_) << ";\n";
+		}
+	}
+	
+	void template_t::write_definition(generator::context& context, generator::code_writer& o, const std::string& view) {
+		if(template_arguments_.empty()) {
+			o << ln(context, line()) << "void " << view << "::" << expr::emit(context, name_) << expr::emit(context, arguments_) << "{\n";
+			write_body(context, o);
+		}
+	}
+
+	void template_t::write_body(generator::context& context, generator::code_writer& o) {
+		trace::scope s(context.tracer, name_->repr(), "template");
+		const size_t size = o.size();
+		if(context.linter)
+			context.linter->begin_template(name_->repr());
+		if(context.minifier)
+			context.minifier->reset();
+		if(context.sizes)
+			context.sizes->begin_template(name_->code(context), name_->code(context) + arguments_->code(context), arguments_->params().size(), line());
 		for(const auto& param : arguments_->params()) {
 			context.add_scope_variable(param.name->code(context));
 		}
-		for(const base_ptr child : children) {
-			child->write(context, o);
+		if(context.hoist_out) {
+			// bound only when the template writes anything, so that there is no unused variable
+			generator::code_writer body;
+			context.out_stream_uses = 0;
+			write_children(context, body);
+			if(context.out_stream_uses > 0)
+				o << ln(context, line()) << "std::ostream &_cppcms_out = out();\n";
+			o.splice(body);
+		} else {
+			write_children(context, o);
 		}
 		
 		for(const auto& param : arguments_->params()) {
 			context.remove_scope_variable(param.name->code(context));
 		}
-		o << ln(endline_) << "} // end of template " << name_->code(context) << "\n";
+		o << ln(context, endline_) << "} // end of template " << expr::emit(context, name_) << "\n";
+		if(context.linter)
+			context.linter->end_template();
+		if(context.sizes)
+			context.sizes->end_template(o.size() - size);
+		s.arg("bytes", o.size() - size);
+		s.arg("nodes", children.size());
 	}
 
 	base_ptr view_t::add_template(const expr::name& name, file_position_t line, const std::vector<expr::identifier> template_arguments, const expr::param_list& arguments) {
+		alloc_stats::scope s(alloc_stats::node, typeid(template_t).name());
 		templates.emplace_back(
 			*name, std::make_shared<template_t>(name, line, template_arguments, arguments, shared_from_this())
 		);
@@ -285,10 +610,32 @@ namespace cppcms { namespace templates { namespace ast {
 			child->dump(o, tabs);
 	}
 	
-	void has_children::write(generator::context& context, std::ostream& o) {
+	void has_children::write(generator::context& context, generator::code_writer& o) {
+		write_children(context, o);
+	}
+
+	void has_children::write_children(generator::context& context, generator::code_writer& o) {
+		for(auto i = children.cbegin(); i != children.cend();) {
+			// text, together with folded ifs holding text only and nodes writing nothing
+			std::vector<const text_t*> run;
+			auto last = i;
+			while(context.coalesce_text && last != children.cend() && (*last)->static_text(context, run))
+				++last;
+			if(last == i) {
+				(*i++)->write(context, o);
+				continue;
+			}
+			text_t::write_run(context, o, run);
+			i = last;
+		}
+	}
+
+	void has_children::clear() {
 		for(const base_ptr& child : children) {
-			child->write(context, o);
+			child->clear();
 		}
+		children.clear();
+		base_t::clear();
 	}
 
 	template_t::template_t(const expr::name& name, file_position_t line, const std::vector<expr::identifier>& template_arguments, const expr::param_list& arguments, base_ptr parent) 
@@ -323,8 +670,8 @@ namespace cppcms { namespace templates { namespace ast {
 		o << p << "c++: " << code_ << std::endl;
 	}
 
-	void cppcode_t::write(generator::context& context, std::ostream& o) {
-		o << ln(line()) << code_->code(context) << std::endl;
+	void cppcode_t::write(generator::context& context, generator::code_writer& o) {
+		o << ln(context, line()) << expr::emit(context, code_) << "\n";
 	}
 
 	base_ptr cppcode_t::end(const std::string&, file_position_t) {
@@ -353,24 +700,43 @@ namespace cppcms { namespace templates { namespace ast {
 		throw std::logic_error("end in non-block component");
 	}
 
-	std::string variable_t::code(generator::context& context, const std::string& escaper) const {
-		const std::string escape = ( escaper.empty() ? "" : escaper + "(" );
-		const std::string close = ( escaper.empty() ? "" : ")" );
+	void variable_t::code(generator::context& context, generator::code_writer& o, const std::string& escaper) const {
+		lint_accessor(context, line(), name_);
 		if(filters_.empty()) {				
-			return escape + name_->code(context) + close;
+			if(escaper.empty())
+				o << expr::emit(context, name_);
+			else
+				o << escaper << "(" << expr::emit(context, name_) << ")";
 		} else {
-			std::string current = name_->code(context);
-			for(auto i = filters_.rbegin(); i != filters_.rend(); ++i) {
-				expr::filter filter = *i;
-				current = filter->argument(current).code(context);
-			}
-			return current;
+			// first filter is the outermost call: f1(f2(...(name)))
+			write_filters(context, o, filters_.begin());
+		}
+	}
+
+	void variable_t::write_filters(generator::context& context, generator::code_writer& o, std::vector<expr::filter>::const_iterator filter) const {
+		if(filter == filters_.end()) {
+			o << expr::emit(context, name_);
+			return;
 		}
+		(*filter)->write(context, o, [&](generator::code_writer& arg) {
+			write_filters(context, arg, filter + 1);
+		});
 	}
 
-	void variable_t::write(generator::context& context, std::ostream& o) {
-		o << ln(line());
-		o << "out() << " << code(context) << ";\n";
+	void variable_t::write(generator::context& context, generator::code_writer& o) {
+		if(context.sizes)
+			context.sizes->expression();
+		o << ln(context, line());
+		if(context.fast_escape && filters_.empty()) {
+			context.add_include("cppcms_tmpl/escape.h");
+			o << "cppcms_tmpl::escape(" << context.out_stream() << ", ";
+			code(context, o, "");
+			o << ");\n";
+			return;
+		}
+		o << context.out_stream() << " << ";
+		code(context, o);
+		o << ";\n";
 	}
 		
 	fmt_function_t::fmt_function_t(	const std::string& name,
@@ -400,43 +766,233 @@ namespace cppcms { namespace templates { namespace ast {
 		throw std::logic_error("end in non-block component");
 	}
 
-	void fmt_function_t::write(generator::context& context, std::ostream& o) {						
-		o << ln(line());
+	// <% gt %> / <% ngt %> with --cache-gt or --locale-catalog, as one block: msgid and plural are the
+	// literals of the template, message the cppcms::locale::translate call, referring to the count of
+	// ngt evaluated once into _cppcms_n
+	static void write_translation(generator::context& context, generator::code_writer& o, const file_position_t& line,
+			const std::string& msgid, const std::string& plural, const std::string& message, const std::string& count,
+			const using_options_t& using_options)
+	{
+		const auto write_formatted = [&](const std::string& format) {
+			o << context.out_stream() << " << cppcms::locale::format(" << format << ")";
+			for(const using_option_t& uo : using_options) {
+				o << " % (";
+				uo.code(context, o);
+				o << ")";
+			}
+			o << ";";
+		};
+		o << "{ ";
+		if(!count.empty())
+			o << "auto const &_cppcms_n = (" << count << "); ";
+		if(context.translator) {
+			// table of the translations in every catalog (all plural forms of each for ngt), picked by
+			// the language of the stream and the plural rule of its catalog
+			context.add_include("cppcms_tmpl/catalog.h");
+			const std::vector<catalog::translation_t> translations = context.translator->translate(line,
+				expr::decode_escaped_string(msgid), plural.empty() ? std::string() : expr::decode_escaped_string(plural));
+			std::vector<size_t> offsets;
+			size_t size = 0;
+			o << "static const cppcms_tmpl::catalog_text _cppcms_tr[] = {";
+			for(const catalog::translation_t& t : translations) {
+				offsets.push_back(size);
+				for(size_t i = 0; i < (plural.empty() ? 1 : t.forms.size()); ++i)
+					o << (size++ ? ", " : " ") << "{ " << catalog::quote(t.forms[i]) << ", " << t.forms[i].size() << " }";
+			}
+			o << " }; const int _cppcms_l = cppcms_tmpl::catalog_language<cppcms::locale::info>(" << context.out_stream() << ", "
+				<< context.translator->languages() << "); if(_cppcms_l >= 0) { ";
+			std::string entry = "_cppcms_tr[_cppcms_l]";
+			if(!plural.empty()) {
+				// out of range forms are the first one, as in gettext
+				if(std::any_of(translations.begin(), translations.end(), [](const catalog::translation_t& t) { return t.plural.find("_cppcms_u") != std::string::npos; }))
+					o << "const unsigned long _cppcms_u = _cppcms_n; ";
+				o << "unsigned long _cppcms_f = 0; switch(_cppcms_l) {";
+				for(size_t i = 0; i < translations.size(); ++i) {
+					o << " case " << i << ": _cppcms_f = " << translations[i].plural << "; _cppcms_f = " << offsets[i]
+						<< " + (_cppcms_f < " << translations[i].forms_declared << " ? _cppcms_f : 0); break;";
+				}
+				o << " } ";
+				entry = "_cppcms_tr[_cppcms_f]";
+			}
+			if(using_options.empty())
+				o << context.out_stream() << ".write(" << entry << ".text, " << entry << ".length);";
+			else
+				write_formatted("std::string(" + entry + ".text, " + entry + ".length)");
+			o << " } else { ";
+		}
+		if(context.cache_gt) {
+			// translated once per locale by a cache owned by the call site
+			context.add_include("cppcms_tmpl/translate.h");
+			const char *n = count.empty() ? "1" : "_cppcms_n";
+			o << "static cppcms_tmpl::translation_cache _cppcms_gt; ";
+			if(using_options.empty())
+				o << "_cppcms_gt.write(" << context.out_stream() << ", " << n << ", " << message << ");";
+			else
+				write_formatted(std::string("_cppcms_gt.get(") + context.out_stream() + ", " + n + ", " + message + ")");
+		} else if(using_options.empty()) {
+			o << context.out_stream() << " << " << message << ";";
+		} else {
+			write_formatted(message);
+		}
+		if(context.translator)
+			o << " }";
+		o << " }\n";
+	}
+
+	// url mapped once per application instance by a cache owned by the call site and thread, arguments
+	// are written into the slots of the mapped url
+	void fmt_function_t::write_cached_url(generator::context& context, generator::code_writer& o) {
+		context.add_include("cppcms_tmpl/url.h");
+		o << "{ static thread_local cppcms_tmpl::url_cache _cppcms_url; ";
+		const char *app = "&content.app().mapper(), typeid(content.app()), ";
+		generator::code_writer map;
+		map << "[&](std::ostream &_cppcms_o) { content.app().mapper().map(_cppcms_o, " << expr::emit(context, fmt_);
+		for(size_t i = 0; i < using_options_.size(); ++i)
+			map << ", cppcms_tmpl::url_slot(" << i << ")";
+		map << "); }";
+		if(using_options_.empty()) {
+			o << "_cppcms_url.write(" << context.out_stream() << ", " << app << map.str() << "); }\n";
+			return;
+		}
+		for(size_t i = 0; i < using_options_.size(); ++i) {
+			o << "auto const &_cppcms_a" << i << " = (";
+			using_options_[i].code(context, o, "cppcms::filters::urlencode");
+			o << "); ";
+		}
+		o << "for(const cppcms_tmpl::url_part &_cppcms_p : _cppcms_url.get(" << app << map.str() << ")) { "
+			<< context.out_stream() << ".write(_cppcms_p.text.data(), _cppcms_p.text.size()); switch(_cppcms_p.slot) {";
+		for(size_t i = 0; i < using_options_.size(); ++i)
+			o << " case " << i << ": " << context.out_stream() << " << _cppcms_a" << i << "; break;";
+		o << " } } }\n";
+	}
+
+	// the format string parsed here instead of by boost::format at render time: literal text is
+	// written as is (escaped now for format), arguments through cppcms_tmpl::format_arg
+	bool fmt_function_t::write_compiled_format(generator::context& context, generator::code_writer& o, bool escape) {
+		const std::string literal = fmt_->repr();
+		std::vector<format_string::piece_t> pieces;
+		size_t arguments = 0;
+		if(!format_string::parse(literal.substr(1, literal.size() - 2), pieces, arguments))
+			return false;
+		if(arguments != using_options_.size()) {
+			throw error_at_line("Format string " + literal + " expects " + boost::lexical_cast<std::string>(arguments)
+				+ " arguments, " + boost::lexical_cast<std::string>(using_options_.size()) + " given", line());
+		}
+		context.add_include("cppcms_tmpl/format.h");
+
+		std::vector<std::string> args;
+		for(const using_option_t& uo : using_options_) {
+			generator::code_writer arg;
+			uo.code(context, arg, "");
+			args.push_back(arg.str());
+		}
+		std::vector<int> uses(args.size());
+		for(const format_string::piece_t& piece : pieces) {
+			if(piece.argument >= 0)
+				uses[piece.argument]++;
+		}
+		// arguments used more than once are evaluated once, like boost::format does
+		const bool bind = std::count_if(uses.begin(), uses.end(), [](int n) { return n > 1; }) > 0;
+		std::vector<std::string> statements;
+		for(size_t i = 0; i < args.size(); ++i) {
+			if(uses[i] == 0) {
+				statements.push_back("(void)(" + args[i] + ");");
+			} else if(uses[i] > 1) {
+				const std::string name = "_cppcms_fmt_" + boost::lexical_cast<std::string>(i + 1);
+				statements.push_back("auto const &" + name + " = (" + args[i] + ");");
+				args[i] = name;
+			}
+		}
+		for(const format_string::piece_t& piece : pieces) {
+			std::ostringstream ss;
+			if(piece.argument < 0) {
+				size_t length = piece.length;
+				const std::string text = escape ? format_string::escape_html(piece.text, length) : piece.text;
+				ss << context.out_stream() << ".write(\"" << text << "\", " << length << ");";
+			} else {
+				ss << "cppcms_tmpl::format_arg(" << context.out_stream() << ", " << args[piece.argument] << ", "
+					<< (escape ? "true" : "false") << ", " << piece.flags;
+				if(piece.width != 0 || piece.precision >= 0 || piece.fill != ' ') {
+					ss << ", " << piece.width << ", " << (piece.precision >= 0 ? piece.precision : 6);
+					if(piece.fill != ' ')
+						ss << ", '" << piece.fill << "'";
+				}
+				ss << ");";
+			}
+			statements.push_back(ss.str());
+		}
+		if(bind)
+			o << "{ ";
+		for(size_t i = 0; i < statements.size(); ++i)
+			o << (i > 0 ? " " : "") << statements[i];
+		o << (bind ? " }\n" : "\n");
+		return true;
+	}
+
+	void fmt_function_t::write(generator::context& context, generator::code_writer& o) {						
+		if(context.sizes)
+			context.sizes->expression();
+		o << ln(context, line());
 		std::string function_name;
 
 		if(name_ == "gt") {
 			function_name = "cppcms::locale::translate";
+			if(context.cache_gt || context.translator) {
+				generator::code_writer message;
+				message << function_name << "(" << expr::emit(context, fmt_) << ")";
+				write_translation(context, o, line(), fmt_->repr(), "", message.str(), "", using_options_);
+				return;
+			}
 		} else if(name_ == "url") {
-			o << "content.app().mapper().map(out(), " << fmt_->code(context);
+			if(context.cache_url) {
+				write_cached_url(context, o);
+				return;
+			}
+			o << "content.app().mapper().map(" << context.out_stream() << ", " << expr::emit(context, fmt_);
 			for(const using_option_t& uo : using_options_) {
-				o << ", " << uo.code(context, "cppcms::filters::urlencode");
+				o << ", ";
+				uo.code(context, o, "cppcms::filters::urlencode");
 			}
 			o << ");\n";
 			return;
 		} else if(name_ == "format") {
+			if(context.compile_format && write_compiled_format(context, o, true))
+				return;
+			if(context.linter && context.linter->in_loop())
+				context.linter->warn(line(), "format in a loop, boost::format parses the format string each time");
 			context.add_include("boost/format.hpp");
-			o << "out() << cppcms::filters::escape("
-				<< "(boost::format(" << fmt_->code(context) << ")";
+			o << context.out_stream() << " << cppcms::filters::escape("
+				<< "(boost::format(" << expr::emit(context, fmt_) << ")";
 			for(const using_option_t& uo : using_options_) {
-				o << "% (" << uo.code(context, "") << ")";					
+				o << "% (";
+				uo.code(context, o, "");
+				o << ")";
 			}
-			o << ").str());";
+			o << ").str());\n";
 			return;
 		} else if(name_ == "rformat") {
+			if(context.compile_format && write_compiled_format(context, o, false))
+				return;
+			if(context.linter && context.linter->in_loop())
+				context.linter->warn(line(), "rformat in a loop, boost::format parses the format string each time");
 			context.add_include("boost/format.hpp");
-			o << "out() << (boost::format(" << fmt_->code(context) << ")";
+			o << context.out_stream() << " << (boost::format(" << expr::emit(context, fmt_) << ")";
 			for(const using_option_t& uo : using_options_) {
-				o << "% (" << uo.code(context, "") << ")";					
+				o << "% (";
+				uo.code(context, o, "");
+				o << ")";
 			}
-			o << ").str();";
+			o << ").str();\n";
 			return;
 		}
 		if(using_options_.empty()) {
-			o << "out() << " << function_name << "(" << fmt_->code(context) << ");\n";
+			o << context.out_stream() << " << " << function_name << "(" << expr::emit(context, fmt_) << ");\n";
 		} else {
-			o << "out() << cppcms::locale::format(" << function_name << "(" << fmt_->code(context) << ")) ";
+			o << context.out_stream() << " << cppcms::locale::format(" << function_name << "(" << expr::emit(context, fmt_) << ")) ";
 			for(const using_option_t& uo : using_options_) {
-				o << " % (" << uo.code(context) << ")";
+				o << " % (";
+				uo.code(context, o);
+				o << ")";
 			}
 			o << ";\n";
 		}
@@ -471,22 +1027,33 @@ namespace cppcms { namespace templates { namespace ast {
 		throw std::logic_error("end in non-block component");
 	}
 
-	void ngt_t::write(generator::context& context, std::ostream& o) {
-		o << ln(line());
+	void ngt_t::write(generator::context& context, generator::code_writer& o) {
+		if(context.sizes)
+			context.sizes->expression();
+		o << ln(context, line());
 		const std::string function_name = "cppcms::locale::translate";
+		if(context.cache_gt || context.translator) {
+			generator::code_writer message, count;
+			message << function_name << "(" << expr::emit(context, singular_) << ", " << expr::emit(context, plural_) << ", _cppcms_n)";
+			count << expr::emit(context, variable_);
+			write_translation(context, o, line(), singular_->repr(), plural_->repr(), message.str(), count.str(), using_options_);
+			return;
+		}
 		
 		if(using_options_.empty()) {
-			o << "out() << " << function_name << "(" 
-				<< singular_->code(context) << ", " 
-				<< plural_->code(context) << ", " 
-				<< variable_->code(context) << ");\n";
+			o << context.out_stream() << " << " << function_name << "(" 
+				<< expr::emit(context, singular_) << ", " 
+				<< expr::emit(context, plural_) << ", " 
+				<< expr::emit(context, variable_) << ");\n";
 		} else {
-			o << "out() << cppcms::locale::format(" << function_name << "(" 
-				<< singular_->code(context) << ", " 
-				<< plural_->code(context) << ", "
-				<< variable_->code(context) << ")) ";
+			o << context.out_stream() << " << cppcms::locale::format(" << function_name << "(" 
+				<< expr::emit(context, singular_) << ", " 
+				<< expr::emit(context, plural_) << ", "
+				<< expr::emit(context, variable_) << ")) ";
 			for(const using_option_t& uo : using_options_) {
-				o << " % (" << uo.code(context) << ")";
+				o << " % (";
+				uo.code(context, o);
+				o << ")";
 			}
 			o << ";\n";
 		}
@@ -527,30 +1094,34 @@ namespace cppcms { namespace templates { namespace ast {
 		throw std::logic_error("end in non-block component");
 	}
 
-	void include_t::write(generator::context& context, std::ostream& o) {
-		o << ln(line());
+	void include_t::write(generator::context& context, generator::code_writer& o) {
+		if(context.sizes)
+			context.sizes->expression();
+		o << ln(context, line());
 		if(from_) {
 			if(!context.check_scope_variable(from_->code(context))) {
 				throw error_at_line("No local view variable " + from_->code(context) + " found in context.", line());
 			}
-			o << name_->code(context) << ";";
+			o << expr::emit(context, name_) << ";";
 		} else if(using_) {
+			if(context.linter && context.linter->in_loop())
+				context.linter->warn(line(), "include using " + using_->repr() + " in a loop, a view object is constructed each time");
 			o << "{\n";
 			if(with_) {
-				o << ln(line()) << "cppcms::base_content::app_guard _g(" << with_->code(context) << ", content);\n";
+				o << ln(context, line()) << "cppcms::base_content::app_guard _g(" << expr::emit(context, with_) << ", content);\n";
 			}
-			o << ln(line()) << using_->code(context) << " _using(out(), ";
+			o << ln(context, line()) << expr::emit(context, using_) << " _using(" << context.out_stream() << ", ";
 			if(with_) {
-				o << with_->code(context);
+				o << expr::emit(context, with_);
 			} else {
 				o << "content";
 			} 
 			o << ");\n";
-			o << ln(line());
-			o << name_->code(context) << ";\n";
-			o << ln(line()) << "}";
+			o << ln(context, line());
+			o << expr::emit(context, name_) << ";\n";
+			o << ln(context, line()) << "}";
 		} else {
-			o << name_->code(context) << ";";
+			o << expr::emit(context, name_) << ";";
 		}
 		o << "\n";
 	}
@@ -577,38 +1148,36 @@ namespace cppcms { namespace templates { namespace ast {
 		}
 	}
 	
-	void form_t::write(generator::context& context, std::ostream& o) {
+	void form_t::write(generator::context& context, generator::code_writer& o) {
 		const std::string mode = context.output_mode;
 		if(style_->repr() == "as_table" || style_->repr() == "as_p" || 
 				style_->repr() == "as_ul" || style_->repr() == "as_dl" ||
 				style_->repr() == "as_space") {
-			o << ln(line()) << "{ ";
-			o << "cppcms::form_context _form_context(out(), cppcms::form_flags::as_" << mode << ", cppcms::form_flags::" << style_->code(context) << "); ";
-			o << "(" << name_->code(context) << ").render(_form_context); ";
+			o << ln(context, line()) << "{ ";
+			o << "cppcms::form_context _form_context(" << context.out_stream() << ", cppcms::form_flags::as_" << mode << ", cppcms::form_flags::" << expr::emit(context, style_) << "); ";
+			o << "(" << expr::emit(context, name_) << ").render(_form_context); ";
 			o << "}\n";
 		} else if(style_->repr() == "input") {
-			o << ln(line()) << " { ";
-			o << "cppcms::form_context _form_context(out(),cppcms::form_flags::as_" << mode << ");\n";
-			o << ln(line()) << "_form_context.widget_part(cppcms::form_context::first_part);\n";
-			o << ln(line()) << "(" << name_->code(context) << ").render_input(_form_context); ";
-			o << ln(line()) << "out() << (" << name_->code(context) << ").attributes_string();\n";
-			o << ln(line()) << "_form_context.widget_part(cppcms::form_context::second_part);\n";
-			o << ln(line()) << "(" << name_->code(context) << ").render_input(_form_context);\n";
-			o << ln(line()) << "}\n";
+			o << ln(context, line()) << " { ";
+			o << "cppcms::form_context _form_context(" << context.out_stream() << ",cppcms::form_flags::as_" << mode << ");\n";
+			o << ln(context, line()) << "_form_context.widget_part(cppcms::form_context::first_part);\n";
+			o << ln(context, line()) << "(" << expr::emit(context, name_) << ").render_input(_form_context); ";
+			o << ln(context, line()) << context.out_stream() << " << (" << expr::emit(context, name_) << ").attributes_string();\n";
+			o << ln(context, line()) << "_form_context.widget_part(cppcms::form_context::second_part);\n";
+			o << ln(context, line()) << "(" << expr::emit(context, name_) << ").render_input(_form_context);\n";
+			o << ln(context, line()) << "}\n";
 		} else if(style_->repr() == "begin" || style_->repr() == "block") {
-			o << ln(line()) << " { ";
-			o << "cppcms::form_context _form_context(out(),cppcms::form_flags::as_" << mode << ");\n";
-			o << ln(line()) << "_form_context.widget_part(cppcms::form_context::first_part);\n";
-			o << ln(line()) << "(" << name_->code(context) << ").render_input(_form_context); ";
-			o << ln(line()) << "}\n";
-			for(const base_ptr& child : children) {
-				child->write(context, o);
-			}
-			o << ln(endline_) << " { ";
-			o << "cppcms::form_context _form_context(out(),cppcms::form_flags::as_" << mode << ");\n";
-			o << ln(endline_) << "_form_context.widget_part(cppcms::form_context::second_part);\n";
-			o << ln(endline_) << "(" << name_->code(context) << ").render_input(_form_context);\n";
-			o << ln(endline_) << "}\n";
+			o << ln(context, line()) << " { ";
+			o << "cppcms::form_context _form_context(" << context.out_stream() << ",cppcms::form_flags::as_" << mode << ");\n";
+			o << ln(context, line()) << "_form_context.widget_part(cppcms::form_context::first_part);\n";
+			o << ln(context, line()) << "(" << expr::emit(context, name_) << ").render_input(_form_context); ";
+			o << ln(context, line()) << "}\n";
+			write_children(context, o);
+			o << ln(context, endline_) << " { ";
+			o << "cppcms::form_context _form_context(" << context.out_stream() << ",cppcms::form_flags::as_" << mode << ");\n";
+			o << ln(context, endline_) << "_form_context.widget_part(cppcms::form_context::second_part);\n";
+			o << ln(context, endline_) << "(" << expr::emit(context, name_) << ").render_input(_form_context);\n";
+			o << ln(context, endline_) << "}\n";
 		}	
 	}
 	
@@ -628,11 +1197,11 @@ namespace cppcms { namespace templates { namespace ast {
 		throw std::logic_error("end in non-block component");
 	}
 	
-	void csrf_t::write(generator::context&, std::ostream& o) {
+	void csrf_t::write(generator::context& context, generator::code_writer& o) {
 		if(!style_) {
-			o << ln(line()) << "out() << \"<input type=\\\"hidden\\\" name=\\\"_csrf\\\" value=\\\"\" << content.app().session().get_csrf_token() << \"\\\" >\\n\";\n";
+			o << ln(context, line()) << context.out_stream() << " << \"<input type=\\\"hidden\\\" name=\\\"_csrf\\\" value=\\\"\" << content.app().session().get_csrf_token() << \"\\\" >\\n\";\n";
 		} else if(style_->repr() == "token") {
-			o << ln(line()) << "out() << content.app().session().get_csrf_token();\n";
+			o << ln(context, line()) << context.out_stream() << " << content.app().session().get_csrf_token();\n";
 		} else if(style_->repr() == "script")  {
 			std::string jscode = R"javascript(                        out() << "\n"
 			"            <script type='text/javascript'>\n"
@@ -652,9 +1221,10 @@ namespace cppcms { namespace templates { namespace ast {
 			"            -->\n"
 			"            </script>\n"
 			"            ";)javascript";
-			o << ln(line()) << jscode << "\n";
+			jscode.replace(jscode.find("out()"), 5, context.out_stream());
+			o << ln(context, line()) << jscode << "\n";
 		} else if(style_->repr() == "cookie") {
-			o << ln(line()) << "out() << content.app().session().get_csrf_token_cookie_name();\n";
+			o << ln(context, line()) << context.out_stream() << " << content.app().session().get_csrf_token_cookie_name();\n";
 		} else {
 			throw std::logic_error("Invalid csrf style: " + style_->repr());
 		}
@@ -687,25 +1257,29 @@ namespace cppcms { namespace templates { namespace ast {
 		throw std::logic_error("end in non-block component");
 	}
 	
-	void render_t::write(generator::context& context, std::ostream& o) {
-		o << ln(line()) << "{\n";
+	void render_t::write(generator::context& context, generator::code_writer& o) {
+		if(context.sizes)
+			context.sizes->expression();
+		if(context.linter && context.linter->in_loop())
+			context.linter->warn(line(), "render of view " + view_->repr() + " in a loop, the view is looked up in the pool and constructed each time");
+		o << ln(context, line()) << "{\n";
 		if(with_) {
-			o << ln(line());
-			o << "cppcms::base_content::app_guard _g(" << with_->code(context) << ", content);\n";
+			o << ln(context, line());
+			o << "cppcms::base_content::app_guard _g(" << expr::emit(context, with_) << ", content);\n";
 		}
-		o << ln(line()) << "cppcms::views::pool::instance().render(";
+		o << ln(context, line()) << "cppcms::views::pool::instance().render(";
 		if(skin_) {
-			o << skin_->code(context);
+			o << expr::emit(context, skin_);
 		} else {
 			o << '"' << context.current_skin << '"';
 		}
-		o << ", " << view_->code(context) << ", out(), ";
+		o << ", " << expr::emit(context, view_) << ", " << context.out_stream() << ", ";
 		if(with_)
-			o << with_->code(context);
+			o << expr::emit(context, with_);
 		else
 			o << "content";
 		o << ");\n";
-		o << ln(line()) << "}\n";
+		o << ln(context, line()) << "}\n";
 	}
 		
 	using_t::using_t(file_position_t line, const expr::identifier& id, const expr::variable& with, const expr::identifier& as, base_ptr parent)
@@ -736,24 +1310,23 @@ namespace cppcms { namespace templates { namespace ast {
 		}
 	}
 	
-	void using_t::write(generator::context& context, std::ostream& o) {
-		o << ln(line()) << "{\n";
+	void using_t::write(generator::context& context, generator::code_writer& o) {
+		o << ln(context, line()) << "{\n";
 		if(with_) {
-			o << ln(line()) << "cppcms::base_content::app_guard _g(" << with_->code(context) << ", content);\n";
+			lint_accessor(context, line(), with_);
+			o << ln(context, line()) << "cppcms::base_content::app_guard _g(" << expr::emit(context, with_) << ", content);\n";
 		}
-		o << ln(line()) << id_->code(context) << " " << as_->code(context) << "(out(), ";
+		o << ln(context, line()) << expr::emit(context, id_) << " " << expr::emit(context, as_) << "(" << context.out_stream() << ", ";
 		if(with_) {
-			o << with_->code(context);
+			o << expr::emit(context, with_);
 		} else {
 			o << "content";
 		}
 		o << ");\n";
 		context.add_scope_variable(as_->code(context));
-		for(const base_ptr& child : children) {
-			child->write(context, o);
-		}
+		write_children(context, o);
 		context.remove_scope_variable(as_->code(context));
-		o << ln(endline_) << "}\n";
+		o << ln(context, endline_) << "}\n";
 	}
 			
 	
@@ -811,28 +1384,101 @@ namespace cppcms { namespace templates { namespace ast {
 	base_ptr if_t::end(const std::string&, file_position_t) {
 		throw std::logic_error("unreachable code (or rather: bug)");
 	}
-	
-	void if_t::write(generator::context& context, std::ostream& o) {
-		auto condition = conditions_.begin();
-		(*condition)->write(context, o);
 
-		for(++condition; condition != conditions_.end(); ++condition) {
-			if((*condition)->type() == type_t::if_else ) {
-				o << " else ";
-			} else {
-				o << "\n" << ln((*condition)->line()) << "else\n";
+	void if_t::clear() {
+		for(const condition_ptr& c : conditions_)
+			c->clear();
+		conditions_.clear();
+		has_children::clear();
+	}
+
+	void if_t::condition_t::clear() {
+		for(const auto& pair : next)
+			pair.first->clear();
+		next.clear();
+		has_children::clear();
+	}
+	
+	void if_t::write(generator::context& context, generator::code_writer& o) {
+		// branches that -D defines rule out are not generated; a branch that is always
+		// taken ends the chain and is written as a plain block when nothing precedes it
+		bool first = true;
+		for(const condition_ptr& condition : conditions_) {
+			const condition_t::folded_t folded = condition->fold(context);
+			if(folded == condition_t::folded_t::never)
+				continue;
+			if(folded == condition_t::folded_t::always) {
+				if(!first)
+					o << " else ";
+				condition->write_body(context, o);
+				o << "\n";
+				return;
 			}
-			(*condition)->write(context, o);
+			if(!first)
+				o << "\n" << ln(context, condition->line()) << "else\n";
+			condition->write(context, o);
+			first = false;
 		}
-		if(conditions_.back()->type() == type_t::if_else) {
-			o << "\n";
-		} else {
+		if(!first)
 			o << " // endif\n";
+	}
+
+	bool if_t::static_text(const generator::context& context, std::vector<const text_t*>& texts) const {
+		for(const condition_ptr& condition : conditions_) {
+			const condition_t::folded_t folded = condition->fold(context);
+			if(folded == condition_t::folded_t::unknown)
+				return false;
+			if(folded == condition_t::folded_t::always)
+				return condition->static_text(context, texts);
 		}
+		return true;
 	}
 
 	if_t::type_t if_t::condition_t::type() const { return type_; }
 
+	if_t::condition_t::folded_t if_t::condition_t::fold_one(const generator::context& context) const {
+		long long value = 0;
+		switch(type_) {
+		case type_t::if_else:
+			return folded_t::always;
+		case type_t::if_regular:
+			if(!context.defines.count(variable_->repr()) || !context.evaluate(variable_->repr(), value))
+				return folded_t::unknown;
+			break;
+		case type_t::if_cpp:
+			if(context.defines.empty() || !context.evaluate(cond_->repr(), value))
+				return folded_t::unknown;
+			break;
+		default:
+			return folded_t::unknown;
+		}
+		return (value != 0) != negate_ ? folded_t::always : folded_t::never;
+	}
+
+	if_t::condition_t::folded_t if_t::condition_t::fold(const generator::context& context) const {
+		// && binds tighter than ||, as in the generated condition
+		folded_t result = folded_t::never, group = fold_one(context);
+		auto close_group = [&result, &group]() {
+			if(group == folded_t::always || result == folded_t::always)
+				result = folded_t::always;
+			else if(group == folded_t::unknown)
+				result = folded_t::unknown;
+		};
+		for(const auto& pair : next) {
+			const folded_t f = pair.first->fold_one(context);
+			if(pair.second == next_op_t::op_or) {
+				close_group();
+				group = f;
+			} else if(group == folded_t::never || f == folded_t::never) {
+				group = folded_t::never;
+			} else if(group != folded_t::always || f != folded_t::always) {
+				group = folded_t::unknown;
+			}
+		}
+		close_group();
+		return result;
+	}
+
 	void if_t::condition_t::dump(std::ostream& o, int tabs)  const {
 		const std::string p(tabs, '\t');
 		auto printer = [&o,&p](const condition_t& self) {
@@ -881,9 +1527,9 @@ namespace cppcms { namespace templates { namespace ast {
 		}
 	}
 	
-	void if_t::condition_t::write(generator::context& context, std::ostream& o) {			
+	void if_t::condition_t::write(generator::context& context, generator::code_writer& o) {			
 		if(type_ != type_t::if_else) {
-			o << ln(line());
+			o << ln(context, line());
 			o << "if(";
 		}
 
@@ -891,21 +1537,28 @@ namespace cppcms { namespace templates { namespace ast {
 			if(self.negate_)
 				o << "!(";
 
+			long long value = 0;
 			switch(self.type_) {
 			case type_t::if_regular:
-				o << "" << self.variable_->code(context) << "";
+				if(context.defines.count(self.variable_->repr()) && context.evaluate(self.variable_->repr(), value)) {
+					o << (value ? "true" : "false");
+				} else {
+					lint_accessor(context, self.line(), self.variable_);
+					o << "" << expr::emit(context, self.variable_) << "";
+				}
 				break;
 
 			case type_t::if_empty:
-				o << "" << self.variable_->code(context) << ".empty()";
+				lint_accessor(context, self.line(), self.variable_);
+				o << "" << expr::emit(context, self.variable_) << ".empty()";
 				break;
 
 			case type_t::if_rtl:
-				o << "(cppcms::locale::translate(\"LTR\").str(out().getloc()) == \"RTL\")";
+				o << "(cppcms::locale::translate(\"LTR\").str(" << context.out_stream() << ".getloc()) == \"RTL\")";
 				break;
 			
 			case type_t::if_cpp:
-				o << "" << self.cond_->code(context) << "";
+				o << "" << expr::emit(context, self.cond_) << "";
 				break;
 
 			case type_t::if_else:
@@ -929,14 +1582,25 @@ namespace cppcms { namespace templates { namespace ast {
 		
 		
 		if(type_ != type_t::if_else) {
-			o << ") {\n";
-		} else {
-			o << " {\n";
+			o << ")";
 		}
-		for(const base_ptr& bp : children) {
-			bp->write(context, o);
+		write_body(context, o);
+	}
+
+	bool if_t::condition_t::static_text(const generator::context& context, std::vector<const text_t*>& texts) const {
+		std::vector<const text_t*> body;
+		for(const base_ptr& child : children) {
+			if(!child->static_text(context, body))
+				return false;
 		}
-		o << ln(endline_) << "} ";
+		texts.insert(texts.end(), body.begin(), body.end());
+		return true;
+	}
+
+	void if_t::condition_t::write_body(generator::context& context, generator::code_writer& o) {
+		o << " {\n";
+		write_children(context, o);
+		o << ln(context, endline_) << "} ";
 	}
 		
 	foreach_t::foreach_t(	file_position_t line, 
@@ -1006,69 +1670,89 @@ namespace cppcms { namespace templates { namespace ast {
 	base_ptr foreach_t::end(const std::string&, file_position_t) {
 		throw std::logic_error("unreachable code (or rather: bug)");
 	}
+
+	void foreach_t::clear() {
+		for(has_children_ptr* part : { &empty_, &separator_, &item_, &item_prefix_, &item_suffix_ }) {
+			if(*part) {
+				(*part)->clear();
+				part->reset();
+			}
+		}
+		base_t::clear();
+	}
 	
-	void foreach_t::write(generator::context& context, std::ostream& o) {
-		const std::string array = "(" + array_->code(context) + ")";
+	void foreach_t::write(generator::context& context, generator::code_writer& o) {
 		const std::string item = name_->code(context);
+		// with bind_foreach the container is evaluated once, into a local reference
+		const std::string array = (context.bind_foreach ? item + "_range" : "(" + array_->code(context) + ")");
 		const std::string rowid = (rowid_ ? rowid_->code(context) : "__rowid");
 		const std::string type = (as_ ? as_->code(context) : ("CPPCMS_TYPEOF(" + array + ".begin())"));
 		const std::string vtype = (as_ ? ("std::iterator_traits <" + type + " >::value_type") : ("CPPCMS_TYPEOF(*" + item + "_ptr)"));
-
-		o << ln(line());
+		const std::string ref = (const_ref_ ? " const & " : " & ");
+		// the separator tests for the first item against a copy of begin(), instead of calling it for every item
+		const bool first = context.bind_foreach && separator_;
+		lint_accessor(context, line(), array_);
+
+		if(context.bind_foreach)
+			o << ln(context, line()) << "{ auto && " << array << " = (" << array_->code(context) << ");\n";
+		o << ln(context, line());
 		o << "if(" << array << ".begin() != " << array << ".end()) {\n";
 		if(rowid_) {
-			o << ln(line()) << "int " << rowid << " = 1;\n";
+			o << ln(context, line()) << "int " << rowid << " = 1;\n";
 		}
 		if(item_prefix_)
 			item_prefix_->write(context, o);
 
-		o << ln(item_->line());
-		o << "for (" <<  type << " "<< item << "_ptr = " << array << ".begin(), " << item << "_ptr_end = " << array << ".end(); " 
-			<< item << "_ptr != " << item << "_ptr_end; ++" << item << "_ptr";
+		o << ln(context, item_->line());
+		o << "for (" <<  type << " "<< item << "_ptr = " << array << ".begin(), " << item << "_ptr_end = " << array << ".end()";
+		if(first)
+			o << ", " << item << "_ptr_first = " << item << "_ptr";
+		o << "; " << item << "_ptr != " << item << "_ptr_end; ++" << item << "_ptr";
 		if(rowid_)
 			o << ", ++" << rowid << ") {\n";
 		else
 			o << ") {\n";
 
-		o << ln(item_->line());
-		if(const_ref_)
-			o << vtype <<" const & " << item << " = *" << item << "_ptr;\n";
-		else
-			o << vtype <<" & " << item << " = *" << item << "_ptr;\n";
+		o << ln(context, item_->line());
+		o << vtype << ref << item << " = *" << item << "_ptr;\n";
 		
 		if(rowid_) 
 			context.add_scope_variable(rowid);
 		context.add_scope_variable(item);
-		if(separator_) {
-			o << ln(separator_->line());
-			o << "if(" << item << "_ptr != " << array << ".begin()) {\n";
-			separator_->write(context, o);
-			o << ln(separator_->endline()) << "} // end of separator\n";
+		{
+			perf_lint::loop l(context.linter);
+			if(separator_) {
+				o << ln(context, separator_->line());
+				o << "if(" << item << "_ptr != " << (first ? item + "_ptr_first" : array + ".begin()") << ") {\n";
+				separator_->write(context, o);
+				o << ln(context, separator_->endline()) << "} // end of separator\n";
+			}
+			item_->write(context, o);
 		}
-		item_->write(context, o);			
 
 		if(rowid_) 
 			context.remove_scope_variable(rowid);
 		context.remove_scope_variable(item);
-		o << ln(item_->endline()) << "} // end of item\n";
+		o << ln(context, item_->endline()) << "} // end of item\n";
 
 		if(item_suffix_)
 			item_suffix_->write(context, o);
 
 		if(empty_) {
-			o << ln(empty_->line());
+			o << ln(context, empty_->line());
 			o << "} else {\n";
 			empty_->write(context, o);
-			o << ln(empty_->endline()) << "} // end of empty\n";
+			o << ln(context, empty_->endline()) << "} // end of empty\n";
 
 		} else {
 			if(item_suffix_)
-				o << ln(item_suffix_->endline());
+				o << ln(context, item_suffix_->endline());
 			else 
-				o << ln(item_->endline());
+				o << ln(context, item_->endline());
 			o << "}\n";
 		}
-
+		if(context.bind_foreach)
+			o << ln(context, empty_ ? empty_->endline() : item_suffix_ ? item_suffix_->endline() : item_->endline()) << "} // end of foreach\n";
 	}
 
 	foreach_t::part_t::part_t(file_position_t line, const std::string& sysname, bool has_end, base_ptr parent) 
@@ -1164,26 +1848,38 @@ namespace cppcms { namespace templates { namespace ast {
 		o << p << "]\n";
 	}
 	
-	void cache_t::write(generator::context& context, std::ostream& o) {
-		o << ln(line()) << "{\n" << "std::string _cppcms_temp_val;\n";
-		o << ln(line()) << "\tif (content.app().cache().fetch_frame(" << name_->code(context) << ", _cppcms_temp_val))\n";
-		o << ln(line()) << "\t\tout() << _cppcms_temp_val;\n";
-		o << ln(line()) << "\telse {\n";
-		o << ln(line()) << "\t\tcppcms::copy_filter _cppcms_cache_flt(out());\n";
+	void cache_t::write(generator::context& context, generator::code_writer& o) {
+		if(context.linter && context.linter->in_loop() && !name_->is_a<expr::string_t>())
+			context.linter->warn(line(), "cache with non-constant key " + name_->repr() + " in a loop, the key is built and looked up each time");
+		if(context.fast_cache) {
+			context.add_include("cppcms_tmpl/cache.h");
+			o << ln(context, line()) << "{\n" << "std::string &_cppcms_temp_val = cppcms_tmpl::frame_buffer();\n";
+		} else {
+			o << ln(context, line()) << "{\n" << "std::string _cppcms_temp_val;\n";
+		}
+		o << ln(context, line()) << "\tif (content.app().cache().fetch_frame(" << expr::emit(context, name_) << ", _cppcms_temp_val))\n";
+		if(context.fast_cache)
+			o << ln(context, line()) << "\t\t" << context.out_stream() << ".write(_cppcms_temp_val.data(), _cppcms_temp_val.size());\n";
+		else
+			o << ln(context, line()) << "\t\t" << context.out_stream() << " << _cppcms_temp_val;\n";
+		o << ln(context, line()) << "\telse {\n";
+		o << ln(context, line()) << "\t\tcppcms::copy_filter _cppcms_cache_flt(" << context.out_stream() << ");\n";
 		if(recording_) {
-			o << ln(line()) << "\t\tcppcms::triggers_recorder _cppcms_trig_rec(content.app().cache());\n";
+			o << ln(context, line()) << "\t\tcppcms::triggers_recorder _cppcms_trig_rec(content.app().cache());\n";
 		}
 		if(miss_) {
-			o << ln(line()) << "\t\t" << miss_->code(context) << ";\n";
+			o << ln(context, line()) << "\t\t" << expr::emit(context, miss_) << ";\n";
 		}
 		has_children::write(context, o);
-		o << ln(endline()) << "content.app().cache().store_frame(" << name_->code(context) << ", _cppcms_cache_flt.detach(),";
+		o << ln(context, endline()) << "content.app().cache().store_frame(" << expr::emit(context, name_) << ", _cppcms_cache_flt.detach(),";
 		if(recording_)
 			o << "_cppcms_trig_rec.detach(),";
+		else if(context.fast_cache)
+			o << "cppcms_tmpl::no_triggers(),";
 		else
 			o << "std::set <std::string > (),";
 		o << duration_ << ", " << (triggers_ ? "false" : "true")  << ");\n";
-		o << ln(endline()) << "\t}} // cache\n";
+		o << ln(context, endline()) << "\t}} // cache\n";
 
 	}
 	
@@ -5,9 +5,11 @@
 #include "generator.h"
 #include "errors.h"
 #include "expr.h"
+#include "alloc_stats.h"
 #include <memory>
 #include <string>
 #include <list>
+#include <typeinfo>
 
 // for demangle only
 #include <cxxabi.h>
@@ -51,6 +53,7 @@ namespace cppcms { namespace templates { namespace ast {
 	class root_t;
 	class template_t;
 	class has_children;
+	class text_t;
 
 	typedef std::shared_ptr<base_t> base_ptr;
 	typedef std::shared_ptr<view_t> view_ptr;
@@ -94,9 +97,14 @@ namespace cppcms { namespace templates { namespace ast {
 			}
 		}
 
-		virtual void write(generator::context& context, std::ostream&) = 0;
+		virtual void write(generator::context& context, generator::code_writer&) = 0;
 		virtual void dump(std::ostream& o, int tabs = 0) const = 0;
 		virtual base_ptr end(const std::string& what, file_position_t line) = 0;
+		// for --coalesce-text: true when the node writes static text only, appending its text nodes
+		// (none when it writes nothing)
+		virtual bool static_text(const generator::context& context, std::vector<const text_t*>& texts) const;
+		// release children and parent, breaks shared pointer cycles so node can be freed
+		virtual void clear();
 		base_ptr parent();
 		const std::string& sysname() const;
 		bool block() const;
@@ -104,9 +112,13 @@ namespace cppcms { namespace templates { namespace ast {
 	
 	class text_t : public base_t {
 		const expr::ptr value_;
+		bool markup() const; // html or xhtml, which context.minifier applies to
 	public:
 		text_t(const expr::ptr& value, file_position_t line, base_ptr parent);
-		virtual void write(generator::context& context, std::ostream&);
+		virtual void write(generator::context& context, generator::code_writer&);
+		virtual bool static_text(const generator::context& context, std::vector<const text_t*>& texts) const;
+		// text nodes as a single literal of known length
+		static void write_run(generator::context& context, generator::code_writer& o, const std::vector<const text_t*>& texts);
 		virtual void dump(std::ostream& o, int tabs = 0) const;
 		virtual base_ptr end(const std::string& what, file_position_t line);
 	};
@@ -130,6 +142,12 @@ namespace cppcms { namespace templates { namespace ast {
 		skins_t::iterator current_skin;
 		std::string mode_;
 		file_position_t mode_line_;
+		
+		void prepare(generator::context& context);
+		void write_codes(generator::context& context, generator::code_writer& o);
+		void write_includes(generator::context& context, generator::code_writer& o);
+		void write_loader(generator::context& context, generator::code_writer& o);
+		void write_stream(generator::context& context, generator::code_writer& o);
 	public:
 		root_t();
 		base_ptr add_skin(const expr::name& name, file_position_t line);
@@ -138,9 +156,11 @@ namespace cppcms { namespace templates { namespace ast {
 		base_ptr add_view(const expr::name& name, file_position_t line, const expr::identifier& data, const expr::name& parent);
 		std::string mode() const;
 		virtual void dump(std::ostream& o, int tabs = 0) const;
-		virtual void write(generator::context& context, std::ostream& o);
+		virtual void write(generator::context& context, generator::code_writer& o);
+		// split output: views.h with declarations, views_N.cpp with definitions and loader.cpp
+		void write_units(generator::context& context, std::vector<generator::unit_t>& units);
 		virtual base_ptr end(const std::string& what, file_position_t line);
-		// TODO: add .clear() method, circular dependencies in shared pointers
+		virtual void clear();
 	};	
 	
 	class view_t : public base_t {
@@ -150,24 +170,32 @@ namespace cppcms { namespace templates { namespace ast {
 		const expr::name name_, master_;
 		const expr::identifier data_;
 		file_position_t endline_;
+		
+		void write_head(generator::context& context, generator::code_writer& o);
 	public:
 		base_ptr add_template(const expr::name& name, file_position_t line, const std::vector<expr::identifier> template_arguments, const expr::param_list& arguments);
 		virtual void dump(std::ostream& o, int tabs = 0) const;
 		view_t(const expr::name& name, file_position_t line, const expr::identifier& data, const expr::name& master, base_ptr parent);
-		virtual void write(generator::context& context, std::ostream& o);
+		virtual void write(generator::context& context, generator::code_writer& o);
+		void write_declaration(generator::context& context, generator::code_writer& o);
+		void write_definitions(generator::context& context, generator::code_writer& o);
 		virtual base_ptr end(const std::string& what, file_position_t line);
+		virtual void clear();
 	};
 
 	class has_children : public base_t {
 	protected:
 		std::vector<base_ptr> children;
 		file_position_t endline_;
+		// with context.coalesce_text, every run of adjacent text nodes is written as one out().write()
+		void write_children(generator::context& context, generator::code_writer& o);
 	public:
 		has_children(const std::string& sysname, file_position_t line, bool block, base_ptr parent);
 		file_position_t endline() const;
 
 		template<typename T, typename... Args>
 		base_ptr add(Args&&... args) { 
+			alloc_stats::scope s(alloc_stats::node, typeid(T).name());
 			children.emplace_back(
 				std::make_shared<T>(
 					std::forward<Args>(args)..., 
@@ -181,17 +209,22 @@ namespace cppcms { namespace templates { namespace ast {
 		}
 		
 		virtual void dump(std::ostream& o, int tabs = 0) const;
-		virtual void write(generator::context& context, std::ostream& o);
+		virtual void write(generator::context& context, generator::code_writer& o);
+		virtual void clear();
 	};
 
 	class template_t : public has_children {
 		const expr::name name_;
 		const std::vector<expr::identifier> template_arguments_;
 		const expr::param_list arguments_;
+
+		void write_body(generator::context& context, generator::code_writer& o);
 	public:
 		template_t(const expr::name& name, file_position_t line, const std::vector<expr::identifier>& template_arguments, const expr::param_list& arguments, base_ptr parent);
 		virtual void dump(std::ostream& o, int tabs = 0) const;
-		virtual void write(generator::context& context, std::ostream& o);
+		virtual void write(generator::context& context, generator::code_writer& o);
+		void write_declaration(generator::context& context, generator::code_writer& o);
+		void write_definition(generator::context& context, generator::code_writer& o, const std::string& view);
 		virtual base_ptr end(const std::string& what, file_position_t line);
 		
 	};
@@ -202,7 +235,7 @@ namespace cppcms { namespace templates { namespace ast {
 	public:
 		cppcode_t(const expr::cpp& code_, file_position_t line, base_ptr parent);
 		virtual void dump(std::ostream& o, int tabs = 0) const;
-		virtual void write(generator::context& context, std::ostream& o);
+		virtual void write(generator::context& context, generator::code_writer& o);
 		virtual base_ptr end(const std::string& what, file_position_t line);
 	};
 
@@ -212,9 +245,11 @@ namespace cppcms { namespace templates { namespace ast {
 	public:
 		variable_t(const expr::variable& name, file_position_t line, const std::vector<expr::filter>& filters, base_ptr parent);
 		virtual void dump(std::ostream& o, int tabs = 0) const;
-		virtual void write(generator::context& context, std::ostream& o);
-		std::string code(generator::context& context, const std::string& escaper = "cppcms::filters::escape") const;
+		virtual void write(generator::context& context, generator::code_writer& o);
+		void code(generator::context& context, generator::code_writer& o, const std::string& escaper = "cppcms::filters::escape") const;
 		virtual base_ptr end(const std::string& what, file_position_t line);
+	private:
+		void write_filters(generator::context& context, generator::code_writer& o, std::vector<expr::filter>::const_iterator filter) const;
 	};
 		
 	typedef variable_t using_option_t;
@@ -225,11 +260,13 @@ namespace cppcms { namespace templates { namespace ast {
 		const std::string name_;
 		const expr::string fmt_;
 		const using_options_t using_options_;
+		bool write_compiled_format(generator::context& context, generator::code_writer& o, bool escape);
+		void write_cached_url(generator::context& context, generator::code_writer& o);
 	public:
 		fmt_function_t(const std::string& name, file_position_t line, const expr::string& fmt, 
 				const using_options_t& uos, base_ptr parent);
 		virtual void dump(std::ostream& o, int tabs = 0) const;
-		virtual void write(generator::context& context, std::ostream& o);
+		virtual void write(generator::context& context, generator::code_writer& o);
 		virtual base_ptr end(const std::string& what, file_position_t line);
 	};
 
@@ -240,7 +277,7 @@ namespace cppcms { namespace templates { namespace ast {
 	public:
 		ngt_t(file_position_t line, const expr::string& singular, const expr::string& plural, const expr::variable& variable, const using_options_t& uos, base_ptr parent);
 		virtual void dump(std::ostream& o, int tabs = 0) const;
-		virtual void write(generator::context& context, std::ostream& o);
+		virtual void write(generator::context& context, generator::code_writer& o);
 		virtual base_ptr end(const std::string& what, file_position_t line);
 	};
 
@@ -253,7 +290,7 @@ namespace cppcms { namespace templates { namespace ast {
 		include_t(const expr::call_list& name, file_position_t line, const expr::identifier& from, 
 				const expr::identifier& _using, const expr::variable& with, base_ptr parent);
 		virtual void dump(std::ostream& o, int tabs = 0) const;
-		virtual void write(generator::context& context, std::ostream& o);
+		virtual void write(generator::context& context, generator::code_writer& o);
 		virtual base_ptr end(const std::string& what, file_position_t line);
 	};
 
@@ -263,7 +300,7 @@ namespace cppcms { namespace templates { namespace ast {
 	public:
 		form_t(const expr::name& style, file_position_t line, const expr::variable& name, base_ptr parent);
 		virtual void dump(std::ostream& o, int tabs = 0) const;
-		virtual void write(generator::context& context, std::ostream& o);
+		virtual void write(generator::context& context, generator::code_writer& o);
 		virtual base_ptr end(const std::string& what, file_position_t line);
 	};
 	
@@ -272,7 +309,7 @@ namespace cppcms { namespace templates { namespace ast {
 	public:
 		csrf_t(file_position_t line, const expr::name& style, base_ptr parent);
 		virtual void dump(std::ostream& o, int tabs = 0) const;
-		virtual void write(generator::context& context, std::ostream& o);
+		virtual void write(generator::context& context, generator::code_writer& o);
 		virtual base_ptr end(const std::string& what, file_position_t line);
 	};
 
@@ -282,7 +319,7 @@ namespace cppcms { namespace templates { namespace ast {
 	public:
 		render_t(file_position_t line, const expr::ptr& skin, const expr::ptr& view, const expr::variable& with, base_ptr parent);
 		virtual void dump(std::ostream& o, int tabs = 0) const;
-		virtual void write(generator::context& context, std::ostream& o);
+		virtual void write(generator::context& context, generator::code_writer& o);
 		virtual base_ptr end(const std::string& what, file_position_t line);
 	};
 
@@ -293,7 +330,7 @@ namespace cppcms { namespace templates { namespace ast {
 	public:
 		using_t(file_position_t line, const expr::identifier& id, const expr::variable& with, const expr::identifier& as, base_ptr parent);
 		virtual void dump(std::ostream& o, int tabs = 0) const;
-		virtual void write(generator::context& context, std::ostream& o);
+		virtual void write(generator::context& context, generator::code_writer& o);
 		virtual base_ptr end(const std::string& what, file_position_t line);
 	};
 
@@ -307,15 +344,24 @@ namespace cppcms { namespace templates { namespace ast {
 			const bool negate_;
 		public:
 			enum class next_op_t { op_or, op_and };
+			enum class folded_t { unknown, never, always };
 		private:
 			std::vector<std::pair<std::shared_ptr<condition_t>, next_op_t>> next;
+			folded_t fold_one(const generator::context& context) const;
 		public:
 			condition_t(file_position_t line, type_t type, const expr::cpp& cond, const expr::variable& variable, bool negate, base_ptr parent);
 			void add_next(const next_op_t& no, const type_t& type, const expr::variable& variable, bool negate);
 			type_t type() const;
+			// value known at template compile time from -D defines
+			folded_t fold(const generator::context& context) const;
 			virtual void dump(std::ostream& o, int tabs = 0) const;
-			virtual void write(generator::context& context, std::ostream& o);
+			virtual void write(generator::context& context, generator::code_writer& o);
+			// { children }, without the condition
+			void write_body(generator::context& context, generator::code_writer& o);
+			// the children, when they are all static text
+			virtual bool static_text(const generator::context& context, std::vector<const text_t*>& texts) const;
 			virtual base_ptr end(const std::string& what, file_position_t line);
+			virtual void clear();
 		};
 		typedef std::shared_ptr<condition_t> condition_ptr;
 	private:
@@ -328,8 +374,11 @@ namespace cppcms { namespace templates { namespace ast {
 		base_ptr add_condition(file_position_t line, const expr::cpp& cond, bool negate);
 		
 		virtual void dump(std::ostream& o, int tabs = 0) const;
-		virtual void write(generator::context& context, std::ostream& o);
+		virtual void write(generator::context& context, generator::code_writer& o);
+		// the branch -D defines select, when it holds text only
+		virtual bool static_text(const generator::context& context, std::vector<const text_t*>& texts) const;
 		virtual base_ptr end(const std::string& what, file_position_t line);
+		virtual void clear();
 	};
 
 	class foreach_t : public base_t {
@@ -351,8 +400,9 @@ namespace cppcms { namespace templates { namespace ast {
 	public:
 		foreach_t(file_position_t line, const expr::name& name, const expr::identifier& as, const expr::name& rowid, const int from, const expr::variable& array, bool reverse, bool const_ref, base_ptr parent);
 		virtual void dump(std::ostream& o, int tabs = 0) const;
-		virtual void write(generator::context& context, std::ostream& o);
+		virtual void write(generator::context& context, generator::code_writer& o);
 		virtual base_ptr end(const std::string& what, file_position_t line);
+		virtual void clear();
 
 		has_children_ptr prefix(file_position_t line);
 		has_children_ptr empty(file_position_t line);
@@ -375,7 +425,7 @@ namespace cppcms { namespace templates { namespace ast {
 		cache_t(file_position_t line, const expr::ptr& name, const expr::variable& miss, int duration, bool recording, bool triggers, base_ptr parent);
 		base_ptr add_trigger(file_position_t line, const expr::ptr&);
 		virtual void dump(std::ostream& o, int tabs = 0) const;
-		virtual void write(generator::context& context, std::ostream& o);
+		virtual void write(generator::context& context, generator::code_writer& o);
 		virtual base_ptr end(const std::string& what, file_position_t line);
 	};
 }}}
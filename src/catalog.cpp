@@ -0,0 +1,174 @@
+#include "catalog.h"
+#include <boost/lexical_cast.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace cppcms { namespace templates { namespace catalog {
+	static const char *english_plural = "_cppcms_u == 1 ? 0 : 1";
+
+	catalog_t::catalog_t(const std::string& language, const std::string& filename)
+		: language_(language)
+		, forms_(2)
+		, plural_(english_plural)
+	{
+		std::ifstream in(filename, std::ios::binary);
+		std::ostringstream ss;
+		if(!in || !(ss << in.rdbuf()))
+			throw std::runtime_error("ERROR: could not read catalog " + filename);
+		const std::string data = ss.str();
+		const auto bad = [&]() { return std::runtime_error("ERROR: " + filename + " is not a valid gettext .mo catalog"); };
+		if(data.size() < 20)
+			throw bad();
+		bool big_endian = false;
+		const auto u32 = [&](size_t pos) -> uint32_t {
+			if(pos + 4 > data.size())
+				throw bad();
+			const unsigned char *p = reinterpret_cast<const unsigned char*>(data.data() + pos);
+			return big_endian
+				? (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3]
+				: (uint32_t(p[3]) << 24) | (uint32_t(p[2]) << 16) | (uint32_t(p[1]) << 8) | p[0];
+		};
+		if(u32(0) != 0x950412de) {
+			big_endian = true;
+			if(u32(0) != 0x950412de)
+				throw bad();
+		}
+		const auto string_at = [&](uint32_t table, uint32_t i) {
+			const uint32_t length = u32(table + 8 * i), offset = u32(table + 8 * i + 4);
+			if(offset > data.size() || length > data.size() - offset)
+				throw bad();
+			return data.substr(offset, length);
+		};
+		const uint32_t count = u32(8), originals = u32(12), translations = u32(16);
+		for(uint32_t i = 0; i < count; ++i) {
+			const std::string key = string_at(originals, i);
+			const std::string value = string_at(translations, i);
+			if(key.empty()) {
+				plural_forms(value);
+				continue;
+			}
+			// messages with a context are not used by templates
+			if(key.find('\4') != std::string::npos)
+				continue;
+			std::vector<std::string> forms;
+			for(size_t begin = 0;;) {
+				const size_t end = value.find('\0', begin);
+				forms.push_back(value.substr(begin, end - begin));
+				if(end == std::string::npos)
+					break;
+				begin = end + 1;
+			}
+			if(std::all_of(forms.begin(), forms.end(), [](const std::string& f) { return f.empty(); }))
+				continue;
+			messages_[key.substr(0, key.find('\0'))] = forms;
+		}
+	}
+
+	// "Plural-Forms: nplurals=N; plural=EXPR;" of the header entry; EXPR is C, it only
+	// gets n renamed and is checked to be made of nothing but numbers and operators
+	void catalog_t::plural_forms(const std::string& header) {
+		const size_t begin = header.find("Plural-Forms:");
+		if(begin == std::string::npos)
+			return;
+		const std::string line = header.substr(begin, header.find('\n', begin) - begin);
+		const size_t nplurals = line.find("nplurals="), plural = line.find("plural=", nplurals == std::string::npos ? 0 : nplurals + 9);
+		if(nplurals == std::string::npos || plural == std::string::npos)
+			throw std::runtime_error("ERROR: catalog for " + language_ + " has invalid Plural-Forms: " + line);
+		const int forms = atoi(line.c_str() + nplurals + 9);
+		std::string expression = line.substr(plural + 7);
+		expression = expression.substr(0, expression.find(';'));
+		std::string code;
+		for(char c : expression) {
+			if(c == 'n')
+				code += "_cppcms_u";
+			else if(strchr("0123456789 \t()?:!=<>&|%+-*/", c))
+				code += c;
+			else
+				throw std::runtime_error("ERROR: catalog for " + language_ + " has unsupported Plural-Forms: " + line);
+		}
+		if(forms <= 0 || code.find_first_not_of(" \t") == std::string::npos)
+			throw std::runtime_error("ERROR: catalog for " + language_ + " has invalid Plural-Forms: " + line);
+		forms_ = forms;
+		plural_ = code;
+	}
+
+	const std::string& catalog_t::language() const {
+		return language_;
+	}
+
+	const std::vector<std::string> *catalog_t::find(const std::string& msgid) const {
+		auto i = messages_.find(msgid);
+		return i == messages_.end() ? nullptr : &i->second;
+	}
+
+	size_t catalog_t::forms() const {
+		return forms_;
+	}
+
+	const std::string& catalog_t::plural() const {
+		return plural_;
+	}
+
+	translator::translator(const std::vector<std::pair<std::string, std::string>>& catalogs) {
+		for(const auto& c : catalogs)
+			catalogs_.emplace_back(c.first, c.second);
+	}
+
+	std::vector<translation_t> translator::translate(const file_position_t& line, const std::string& msgid, const std::string& plural) {
+		std::vector<translation_t> result;
+		for(const catalog_t& c : catalogs_) {
+			const std::vector<std::string> *forms = c.find(msgid);
+			if(forms && (plural.empty() || forms->size() > 1)) {
+				result.push_back(translation_t { *forms, plural.empty() ? std::string() : c.plural(), std::min(c.forms(), forms->size()) });
+				continue;
+			}
+			const std::string msg = "untranslated string " + quote(msgid) + " in catalog " + c.language();
+			diagnostics_.push_back({ diagnostic_t::severity_t::warning, line, msg,
+				"WARNING: " + msg + " at line " + line.filename + ":" + boost::lexical_cast<std::string>(line.line) });
+			if(plural.empty())
+				result.push_back(translation_t { { msgid }, std::string(), 1 });
+			else
+				result.push_back(translation_t { { msgid, plural }, english_plural, 2 });
+		}
+		return result;
+	}
+
+	std::string translator::languages() const {
+		std::string value;
+		for(const catalog_t& c : catalogs_)
+			value += c.language() + '\0';
+		return quote(value);
+	}
+
+	const std::vector<diagnostic_t>& translator::diagnostics() const {
+		return diagnostics_;
+	}
+
+	std::string quote(const std::string& value) {
+		static const char digits[] = "01234567";
+		std::string literal = "\"";
+		for(size_t i = 0; i < value.size(); ++i) {
+			const unsigned char c = value[i];
+			if(c == '"' || c == '\\') {
+				literal += '\\';
+				literal += c;
+			} else if(c == '?' && i > 0 && value[i - 1] == '?') {
+				literal += "\\?"; // no trigraphs
+			} else if(c < 0x20 || c >= 0x7f) {
+				// three octal digits, so a digit after it is not taken as part of it
+				literal += '\\';
+				literal += digits[c >> 6];
+				literal += digits[(c >> 3) & 7];
+				literal += digits[c & 7];
+			} else {
+				literal += c;
+			}
+		}
+		return literal + "\"";
+	}
+}}}
@@ -0,0 +1,55 @@
+#ifndef CPPCMS_TEMPLATE_COMPILER_CATALOG_H
+#define CPPCMS_TEMPLATE_COMPILER_CATALOG_H
+#include "errors.h"
+#include "parser_source.h"
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cppcms { namespace templates { namespace catalog {
+	// gettext .mo catalog of one language, read when templates are compiled
+	class catalog_t {
+		std::string language_;
+		std::map<std::string, std::vector<std::string>> messages_; // msgid (singular for plurals) -> forms
+		size_t forms_;
+		std::string plural_; // Plural-Forms expression as C++, n being _cppcms_u (the count as unsigned long)
+
+		void plural_forms(const std::string& header);
+	public:
+		// throws std::runtime_error when file can not be read or is not a valid catalog
+		catalog_t(const std::string& language, const std::string& filename);
+		const std::string& language() const;
+		// translations of msgid, nullptr when catalog does not translate it
+		const std::vector<std::string> *find(const std::string& msgid) const;
+		size_t forms() const;
+		const std::string& plural() const;
+	};
+
+	// one gt/ngt string in one catalog
+	struct translation_t {
+		std::vector<std::string> forms; // one for gt
+		std::string plural; // expression of the form for the count _cppcms_u (ngt only)
+		size_t forms_declared; // nplurals of the catalog, the form is clamped to it as gettext does
+	};
+
+	// translations of gt / ngt strings from the catalogs given to the compiler (--locale-catalog),
+	// fed by ast nodes while code is generated (context.translator); strings a catalog does not
+	// translate are reported and written in the original language
+	class translator {
+		std::vector<catalog_t> catalogs_;
+		std::vector<diagnostic_t> diagnostics_;
+	public:
+		// language, .mo file pairs
+		explicit translator(const std::vector<std::pair<std::string, std::string>>& catalogs);
+		// msgid and plural are values (not literals), plural is empty for gt
+		std::vector<translation_t> translate(const file_position_t& line, const std::string& msgid, const std::string& plural);
+		// "de\0fr\0" as a C string literal, what cppcms_tmpl::catalog_language expects
+		std::string languages() const;
+		const std::vector<diagnostic_t>& diagnostics() const;
+	};
+
+	// C string literal of any bytes
+	std::string quote(const std::string& value);
+}}}
+#endif
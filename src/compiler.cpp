@@ -0,0 +1,75 @@
+#include "compiler.h"
+#include "parser.h"
+#include "trace.h"
+#include "perf_lint.h"
+#include "minify.h"
+#include "catalog.h"
+#include "alloc_stats.h"
+#include <sstream>
+
+namespace cppcms { namespace templates {
+	static diagnostic_t make_diagnostic(diagnostic_t::severity_t severity, const file_position_t& line, const std::string& message, const std::string& text) {
+		return diagnostic_t { severity, line, message, text };
+	}
+
+	compile_result_t compile(const std::vector<source_file_t>& sources, const generator::context& context, std::ostream& output) {
+		compile_result_t result { false, std::string(), std::vector<generator::unit_t>(), std::vector<diagnostic_t>() };
+		const file_position_t unknown { std::string(), 0 };
+		try {
+			generator::context ctx(context);
+			perf_lint::linter linter;
+			if(ctx.perf_lint)
+				ctx.linter = &linter;
+			minify::minifier minifier;
+			if(ctx.minify)
+				ctx.minifier = &minifier;
+			catalog::translator translator(ctx.locale_catalogs);
+			if(!ctx.locale_catalogs.empty())
+				ctx.translator = &translator;
+			template_parser p(sources);
+			try {
+				{
+					trace::scope s(ctx.tracer, "parse", "phase");
+					alloc_stats::scope a(alloc_stats::phase, "parse");
+					size_t bytes = 0;
+					for(const source_file_t& source : sources)
+						bytes += source.content.size();
+					s.arg("files", sources.size());
+					s.arg("bytes", bytes);
+					p.parse();
+				}
+				trace::scope s(ctx.tracer, "codegen", "phase");
+				alloc_stats::scope a(alloc_stats::phase, "codegen");
+				if(ctx.split_output) {
+					p.write_units(ctx, result.units);
+				} else {
+					p.write(ctx, output);
+				}
+				result.ok = true;
+			} catch(...) {
+				result.diagnostics = p.warnings();
+				p.tree()->clear();
+				throw;
+			}
+			result.diagnostics = p.warnings();
+			result.diagnostics.insert(result.diagnostics.end(), linter.diagnostics().begin(), linter.diagnostics().end());
+			result.diagnostics.insert(result.diagnostics.end(), translator.diagnostics().begin(), translator.diagnostics().end());
+			p.tree()->clear(); // break parent/child cycles, so the tree is freed
+		} catch(const parse_error& e) {
+			result.diagnostics.push_back(make_diagnostic(diagnostic_t::severity_t::error, e.line(), e.reason(), e.what()));
+		} catch(const std::logic_error& e) {
+			result.diagnostics.push_back(make_diagnostic(diagnostic_t::severity_t::bug, unknown, e.what(), std::string("logic error(bug): ") + e.what()));
+		} catch(const std::runtime_error& e) {
+			result.diagnostics.push_back(make_diagnostic(diagnostic_t::severity_t::error, unknown, e.what(), e.what()));
+		}
+		return result;
+	}
+
+	compile_result_t compile(const std::vector<source_file_t>& sources, const generator::context& context) {
+		std::ostringstream oss;
+		compile_result_t result = compile(sources, context, oss);
+		if(result.ok)
+			result.code = oss.str();
+		return result;
+	}
+}}
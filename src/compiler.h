@@ -0,0 +1,27 @@
+#ifndef CPPCMS_TEMPLATE_COMPILER_COMPILER_H
+#define CPPCMS_TEMPLATE_COMPILER_COMPILER_H
+#include "parser_source.h"
+#include "generator.h"
+#include "errors.h"
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace cppcms { namespace templates {
+	struct compile_result_t {
+		bool ok;
+		std::string code;
+		// generated files, when context.split_output is set
+		std::vector<generator::unit_t> units;
+		std::vector<diagnostic_t> diagnostics;
+	};
+
+	// compile in-memory sources, generated code is returned in result.code
+	// context is copied, so one configured context can be reused for many compilations
+	compile_result_t compile(const std::vector<source_file_t>& sources, const generator::context& context);
+
+	// same as above, but generated code is written to output instead of result.code
+	// (split output is always returned in result.units)
+	compile_result_t compile(const std::vector<source_file_t>& sources, const generator::context& context, std::ostream& output);
+}}
+#endif
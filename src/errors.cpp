@@ -8,4 +8,17 @@ namespace cppcms { namespace templates {
 	error_at_line::error_at_line(const std::string& msg, const file_position_t& line)
 		: std::runtime_error(msg)
 		, line_(line) {}  
+
+	parse_error::parse_error(const std::string& msg, const file_position_t& line, const std::string& reason)
+		: std::runtime_error(msg)
+		, line_(line)
+		, reason_(reason) {}
+
+	const file_position_t& parse_error::line() const {
+		return line_;
+	}
+
+	const std::string& parse_error::reason() const {
+		return reason_;
+	}
 }}
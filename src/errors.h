@@ -11,9 +11,24 @@ namespace cppcms { namespace templates {
 	};
 
 	class parse_error : public std::runtime_error {
-		using std::runtime_error::runtime_error;
+		const file_position_t line_;
+		const std::string reason_;
+	public:
+		parse_error(const std::string& msg, const file_position_t& line, const std::string& reason);
+		const file_position_t& line() const;
+		// message without source context
+		const std::string& reason() const;
 	};
 	
+	struct diagnostic_t {
+		enum class severity_t { warning, error, bug };
+		severity_t severity;
+		file_position_t line;
+		std::string message;
+		// message with position and source context, as printed by command line tool
+		std::string text;
+	};
+
 	class bad_cast : public std::runtime_error {
 	public:
 		using std::runtime_error::runtime_error;
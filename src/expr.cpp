@@ -15,81 +15,49 @@ namespace cppcms { namespace templates { namespace expr {
 		return std::string(&input[beg], &input[end]);
 	}
 	
-	static std::string decode_escaped_string(const std::string& input) {
+	std::string decode_escaped_string(const std::string& literal) {
 		std::string result;
-		bool escaped = false;
-		const int hex[256] = 
-			{ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 
-			  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 
-			  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 
-			  0, 1, 2, 3, 4, 5, 6, 7, 8, 9, -1, -1, -1, -1, -1, -1, 
-			  -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, 
-			  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 
-			  -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, 
-			  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 
-			  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 
-			  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 
-			  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 
-			  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 
-			  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 
-			  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 
-			  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 
-			  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 };
-		for(size_t i = 0; i < input.length(); ++i) {
-			char current = input[i];
-			if(escaped) {
-				escaped = false;
-				int value;
-				char o1,o2,o3;
-				switch(current) {					
-					case '\'':
-					case '?':
-					case '\\':
-						result += current;
-						break;
-					case '"': result += "\\\""; break;
-					case 'a': result += '\a'; break;
-					case 'b': result += '\b'; break;
-					case 'f': result += '\f'; break;
-					case 'n': result += '\n'; break;
-					case 'r': result += '\r'; break;
-					case 't': result += '\t'; break;
-					case 'v': result += '\v'; break;
-							  							  
-					case 'x':
-						  if(i+2 >= input.length())
-							  throw std::runtime_error("Invalid escape sequence: " + std::string(&input[i-1], &input[input.length()-1]));
-						  value = hex[static_cast<int>(input[i+1])]*16 + hex[static_cast<int>(input[i+2])];
-						  if(value < 0)
-							  throw std::runtime_error("Invalid escape sequence: " + std::string(&input[i-1], &input[i+3]));
-						  result += static_cast<char>(value);
-						  break;
-					// TODO: unicode characters
-					default:
-						if(input[i] >= '0' && input[i] <= '7') {
-							if(i+3 >= input.length())
-								throw std::runtime_error("Invalid escape sequence: " + std::string(&input[i-1], &input[input.length()-1]));
-							o1 = input[i+1], o2 = input[i+2], o3 = input[i+3];
-							if(o2 >= '0' && o2 <= '7' && o3 >= '0' && o3 <= '7') {
-								o1 -= '0'; o2 -= '0'; o3 -= '0';
-								result += static_cast<char>(o1*64+o2*8+o3);
-							} else {
-								throw std::runtime_error("Invalid escape sequence: " + std::string(&input[i-1], &input[i+4]));
-							}
-						} else {
-							result += '\\';
-							result += current;
-						}
-						break;
-				}
-			} else if(input[i] == '\\') {
-				escaped = true;
-			} else {
+		const size_t end = literal.size() > 0 ? literal.size() - 1 : 0;
+		auto hex = [](char c) {
+			return c >= '0' && c <= '9' ? c - '0' : c >= 'a' && c <= 'f' ? c - 'a' + 10 : c >= 'A' && c <= 'F' ? c - 'A' + 10 : -1;
+		};
+		for(size_t i = 1; i < end; ++i) {
+			const char current = literal[i];
+			if(current != '\\' || i + 1 == end) {
 				result += current;
+				continue;
+			}
+			const size_t start = i;
+			switch(const char c = literal[++i]) {
+				case 'a': result += '\a'; break;
+				case 'b': result += '\b'; break;
+				case 'f': result += '\f'; break;
+				case 'n': result += '\n'; break;
+				case 'r': result += '\r'; break;
+				case 't': result += '\t'; break;
+				case 'v': result += '\v'; break;
+				case 'x': {
+					int value = 0, digits = 0;
+					for(; digits < 2 && i + 1 < end && hex(literal[i + 1]) >= 0; ++digits)
+						value = value * 16 + hex(literal[++i]);
+					if(digits == 0)
+						throw std::runtime_error("Invalid escape sequence: " + literal.substr(start, i + 1 - start));
+					result += static_cast<char>(value);
+					break;
+				}
+				// TODO: unicode characters
+				default:
+					if(c >= '0' && c <= '7') {
+						int value = c - '0';
+						for(int digits = 1; digits < 3 && i + 1 < end && literal[i + 1] >= '0' && literal[i + 1] <= '7'; ++digits)
+							value = value * 8 + (literal[++i] - '0');
+						result += static_cast<char>(value);
+					} else {
+						result += c; // \\ \" \' \?
+					}
+					break;
 			}
 		}
-		if(escaped)
-			result += '\\';
 		return result;
 	}
 	
@@ -215,12 +183,48 @@ namespace cppcms { namespace templates { namespace expr {
 	base_t::base_t(const std::string& value)
 		: value_(value) {}
 
+	std::string base_t::code(generator::context& context) const {
+		generator::code_writer o;
+		write(context, o);
+		return o.str();
+	}
+
 	std::string text_t::repr() const { 
 		return "\"" + value_ + "\"";
 	}
 
-	std::string text_t::code(generator::context&) const {
-		return "\"" + value_ + "\"";
+	const std::string& text_t::escaped() const {
+		return value_;
+	}
+
+	size_t text_t::length() const {
+		// compress_html escapes every character with a two character sequence
+		size_t n = 0;
+		for(size_t i = 0; i < value_.size(); ++i, ++n) {
+			if(value_[i] == '\\')
+				++i;
+		}
+		return n;
+	}
+
+	std::string text_t::unescaped() const {
+		static const std::string from = "abfnrtv", to = "\a\b\f\n\r\t\v";
+		std::string result;
+		result.reserve(value_.size());
+		for(size_t i = 0; i < value_.size(); ++i) {
+			if(value_[i] != '\\' || i + 1 == value_.size()) {
+				result += value_[i];
+				continue;
+			}
+			const char c = value_[++i];
+			const size_t n = from.find(c);
+			result += n == std::string::npos ? c : to[n];
+		}
+		return result;
+	}
+
+	void text_t::write(generator::context&, generator::code_writer& o) const {
+		o << '"' << value_ << '"';
 	}
 
 	double number_t::real() const {
@@ -235,8 +239,8 @@ namespace cppcms { namespace templates { namespace expr {
 		return value_;
 	}
 	
-	std::string number_t::code(generator::context&) const {
-		return value_;
+	void number_t::write(generator::context&, generator::code_writer& o) const {
+		o << value_;
 	}
 
 	variable_t::variable_t(const std::string& input, bool consume_all, size_t* pos) 
@@ -452,38 +456,37 @@ namespace cppcms { namespace templates { namespace expr {
 			
 	bool filter_t::is_exp() const { return exp_; }
 
-	std::string filter_t::code(generator::context& context) const {
-		if(exp_) {
-			return call_list_t::code(context);
-		} else {
-			return call_list_t::code(context);
-		}
+	void call_list_t::write(generator::context& context, generator::code_writer& o) const {
+		write(context, o, argument_writer_t());
 	}
 
-	std::string call_list_t::code(generator::context& context) const {
-		std::ostringstream oss;
+	void call_list_t::write(generator::context& context, generator::code_writer& o, const argument_writer_t& first_argument) const {
 		if(function_prefix_ == "$var")
-			oss << context.variable_prefix << value_ << "(  ";
+			o << context.variable_prefix << value_ << "(";
 		else
-			oss << function_prefix_ << value_ << "(  ";
-		if(!current_argument_.empty())
-			oss << current_argument_ << ", ";
+			o << function_prefix_ << value_ << "(";
+		if(first_argument || !arguments_.empty())
+			o << "  ";
+		bool first = true;
+		if(first_argument) {
+			first_argument(o);
+			first = false;
+		}
 		for(const ptr& x : arguments_) {
-			if(x->is_a<expr::variable_t>())
-				oss << x->as<expr::variable_t>().code(context) << ", ";
-			else
-				oss << x->code(context) << ", ";
+			if(!first)
+				o << ", ";
+			x->write(context, o);
+			first = false;
 		}
-		const std::string result = oss.str();
-		return result.substr(0, result.length()-2) + ")";
+		o << ")";
 	}
 
-	std::string variable_t::code(generator::context& context) const {
+	void variable_t::write(generator::context& context, generator::code_writer& o) const {
 		if(value_ == "true" || value_ == "false") {
-			return value_;
+			o << value_;
+			return;
 		}
 
-		std::ostringstream o;
 		if(is_deref) { 
 			o << "*";
 		}
@@ -497,7 +500,7 @@ namespace cppcms { namespace templates { namespace expr {
 			}
 
 			if(part.subscript) {
-				o << "[" << part.subscript->code(context) << "]";
+				o << "[" << emit(context, part.subscript) << "]";
 			}
 			first = false;			
 			if(part.is_function) {
@@ -505,22 +508,20 @@ namespace cppcms { namespace templates { namespace expr {
 				for(auto i = part.arguments.begin(); i != part.arguments.end(); ++i) {
 					if(i != part.arguments.begin())
 						o << ", ";
-					o << (*i)->code(context);
+					(*i)->write(context, o);
 				}
 				o << ")";
 			}
 			o << part.separator;
 		}
-
-		return o.str();
 	}
 
 	std::string string_t::repr() const { 
 		return value_;
 	}
 	
-	std::string string_t::code(generator::context&) const {
-		return value_;
+	void string_t::write(generator::context&, generator::code_writer& o) const {
+		o << value_;
 	}
 
 	
@@ -528,8 +529,8 @@ namespace cppcms { namespace templates { namespace expr {
 		return value_;
 	}
 	
-	std::string cpp_t::code(generator::context&) const { 
-		return value_;
+	void cpp_t::write(generator::context&, generator::code_writer& o) const {
+		o << value_;
 	}
 	
 
@@ -546,11 +547,6 @@ namespace cppcms { namespace templates { namespace expr {
 		return result;
 	}
 
-	call_list_t& call_list_t::argument(const std::string& arg) {
-		current_argument_ = arg;
-		return *this;
-	}
-		
 	std::string string_t::unescaped() const {
 		return decode_escaped_string(value_);
 	}
@@ -562,16 +558,16 @@ namespace cppcms { namespace templates { namespace expr {
 		return value_;
 	}
 	
-	std::string name_t::code(generator::context&) const {
-		return value_;
+	void name_t::write(generator::context&, generator::code_writer& o) const {
+		o << value_;
 	}
 	
 	std::string identifier_t::repr() const {
 		return value_;
 	}
 		
-	std::string identifier_t::code(generator::context&) const {
-		return value_;
+	void identifier_t::write(generator::context&, generator::code_writer& o) const {
+		o << value_;
 	}
 	
 	param_list_t::param_list_t(const std::string& input, const params_t& params)
@@ -584,8 +580,8 @@ namespace cppcms { namespace templates { namespace expr {
 		return value_;
 	}
 	
-	std::string param_list_t::code(generator::context&) const {
-		return value_;
+	void param_list_t::write(generator::context&, generator::code_writer& o) const {
+		o << value_;
 	}
 
 	bool name_t::operator<(const name_t& rhs) const {
@@ -5,6 +5,7 @@
 
 #include <memory>
 #include <string>
+#include <functional>
 
 namespace cppcms { namespace templates { namespace expr {
 	class base_t;	
@@ -51,7 +52,10 @@ namespace cppcms { namespace templates { namespace expr {
 		const T& as() const { return dynamic_cast<const T&>(*this); }
 
 		virtual std::string repr() const = 0;
-		virtual std::string code(generator::context&) const = 0;
+		// appends generated code to o
+		virtual void write(generator::context&, generator::code_writer& o) const = 0;
+		// generated code as string, for names used outside of code output
+		std::string code(generator::context&) const;
 		virtual ~base_t() {}
 	};
 
@@ -59,7 +63,11 @@ namespace cppcms { namespace templates { namespace expr {
 	public:
 		using base_t::base_t;
 		virtual std::string repr() const;
-		virtual std::string code(generator::context&) const;
+		// content as written between quotes, and its length once unescaped
+		const std::string& escaped() const;
+		size_t length() const;
+		std::string unescaped() const;
+		virtual void write(generator::context&, generator::code_writer& o) const;
 	};
 
 	class html_t : public text_t { using text_t::text_t; };
@@ -71,7 +79,7 @@ namespace cppcms { namespace templates { namespace expr {
 		double real() const;
 		int integer() const;
 		virtual std::string repr() const;
-		virtual std::string code(generator::context&) const;
+		virtual void write(generator::context&, generator::code_writer& o) const;
 	};
 
 	class variable_t : public base_t {
@@ -88,7 +96,7 @@ namespace cppcms { namespace templates { namespace expr {
 		variable_t(const std::string&, bool consume_all = true,  size_t* pos = nullptr);
 		
 		virtual std::string repr() const;
-		virtual std::string code(generator::context&) const;
+		virtual void write(generator::context&, generator::code_writer& o) const;
 	private:
 		std::vector<ptr> parse_arguments(const std::string&, size_t&);			
 		ptr parse_string(const std::string&, size_t&);	
@@ -101,7 +109,7 @@ namespace cppcms { namespace templates { namespace expr {
 		string_t(const std::string&);
 		std::string repr() const;
 		virtual std::string unescaped() const;
-		virtual std::string code(generator::context&) const;
+		virtual void write(generator::context&, generator::code_writer& o) const;
 	};
 
 	class name_t : public base_t {
@@ -109,25 +117,27 @@ namespace cppcms { namespace templates { namespace expr {
 		using base_t::base_t;
 		bool operator<(const name_t& rhs) const;
 		std::string repr() const;
-		virtual std::string code(generator::context&) const;
+		virtual void write(generator::context&, generator::code_writer& o) const;
 	};
 	
 	class identifier_t : public base_t {
 	public:
 		using base_t::base_t;
 		std::string repr() const;
-		virtual std::string code(generator::context&) const;
+		virtual void write(generator::context&, generator::code_writer& o) const;
 	};
 	
 	class call_list_t : public base_t {
 		const std::vector<ptr> arguments_;
 		const std::string function_prefix_;
-		std::string current_argument_;
 	public:
+		typedef std::function<void(generator::code_writer&)> argument_writer_t;
+
 		call_list_t(const std::string& expr, const std::string& function_prefix); 
-		call_list_t& argument(const std::string&);
 		std::string repr() const;
-		virtual std::string code(generator::context& context) const;
+		virtual void write(generator::context& context, generator::code_writer& o) const;
+		// same as above, with first argument written by first_argument
+		void write(generator::context& context, generator::code_writer& o, const argument_writer_t& first_argument) const;
 	};
 	
 	class param_list_t : public base_t {
@@ -144,26 +154,24 @@ namespace cppcms { namespace templates { namespace expr {
 		std::string repr() const;
 		const params_t& params() const;
 					
-		virtual std::string code(generator::context& context) const;
+		virtual void write(generator::context& context, generator::code_writer& o) const;
 	private:
 		const params_t params_;
 	};
 	
 	class filter_t : public call_list_t {
 		const bool exp_;
-		const std::string current_argument_;
 	public:
 		using call_list_t::call_list_t;
 		filter_t(const std::string&);		
 		bool is_exp() const;
-		virtual std::string code(generator::context& context) const;
 	};
 
 	class cpp_t : public base_t { 
 	public:
 		using base_t::base_t;
 		std::string repr() const;
-		virtual std::string code(generator::context& context) const;
+		virtual void write(generator::context& context, generator::code_writer& o) const;
 	};
 	
 	number make_number(const std::string& repr);
@@ -178,9 +186,25 @@ namespace cppcms { namespace templates { namespace expr {
 	text make_text(const std::string& repr);
 	html make_html(const std::string& repr);
 	xhtml make_xhtml(const std::string& repr);
+
+	// value of a C string literal, quotes included, such as the repr() of string_t
+	std::string decode_escaped_string(const std::string& literal);
 	
 
 
+	// expression code for code_writer chains: o << expr::emit(context, x)
+	struct emit_t {
+		generator::context& context;
+		const base_t& expr;
+	};
+	inline emit_t emit(generator::context& context, const base_t& expr) { return emit_t { context, expr }; }
+	template<typename T>
+	emit_t emit(generator::context& context, const std::shared_ptr<T>& expr) { return emit_t { context, *expr }; }
+	inline generator::code_writer& operator<<(generator::code_writer& o, const emit_t& e) {
+		e.expr.write(e.context, o);
+		return o;
+	}
+
 	std::ostream& operator<<(std::ostream& o, const name_t& obj);
 	std::ostream& operator<<(std::ostream& o, const identifier_t& obj);
 	std::ostream& operator<<(std::ostream& o, const string_t& obj);
@@ -0,0 +1,184 @@
+#include "format_string.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+namespace cppcms { namespace templates { namespace format_string {
+	static piece_t text_piece(const std::string& text, size_t length) {
+		return piece_t { text, length, -1, std::string(), 0, -1, ' ' };
+	}
+
+	// reads digits at literal[pos], -1 when there are none
+	static int number(const std::string& literal, size_t& pos) {
+		int n = -1;
+		for(; pos < literal.size() && isdigit(static_cast<unsigned char>(literal[pos])); ++pos)
+			n = (n < 0 ? 0 : n * 10) + (literal[pos] - '0');
+		return n;
+	}
+
+	// printf like specification after '%' (and after "N$"), as boost::format reads it
+	static bool specification(const std::string& literal, size_t& pos, piece_t& piece) {
+		bool left = false, zero = false, showpos = false, alternate = false;
+		for(; pos < literal.size() && strchr("-0+#", literal[pos]); ++pos) {
+			switch(literal[pos]) {
+			case '-': left = true; break;
+			case '0': zero = true; break;
+			case '+': showpos = true; break;
+			default: alternate = true; break;
+			}
+		}
+		const int width = number(literal, pos);
+		int precision = -1;
+		if(pos < literal.size() && literal[pos] == '.') {
+			++pos;
+			precision = number(literal, pos);
+			if(precision < 0)
+				precision = 0;
+		}
+		while(pos < literal.size() && strchr("hlLqjzt", literal[pos]))
+			++pos;
+		if(pos == literal.size())
+			return false;
+		const char type = literal[pos++];
+		std::string base = "dec", floatfield;
+		bool uppercase = false;
+		switch(type) {
+		case 'd': case 'i': case 'u': break;
+		case 's': case 'S':
+			// precision truncates strings in boost::format
+			if(precision >= 0)
+				return false;
+			break;
+		case 'o': base = "oct"; break;
+		case 'x': case 'p': base = "hex"; break;
+		case 'X': base = "hex"; uppercase = true; break;
+		case 'e': floatfield = "scientific"; break;
+		case 'E': floatfield = "scientific"; uppercase = true; break;
+		case 'f': floatfield = "fixed"; break;
+		case 'F': floatfield = "fixed"; uppercase = true; break;
+		case 'g': break;
+		case 'G': uppercase = true; break;
+		default: return false;
+		}
+		piece.flags = "std::ios_base::skipws | std::ios_base::" + base;
+		if(!floatfield.empty())
+			piece.flags += " | std::ios_base::" + floatfield;
+		if(uppercase)
+			piece.flags += " | std::ios_base::uppercase";
+		if(showpos)
+			piece.flags += " | std::ios_base::showpos";
+		if(alternate)
+			piece.flags += " | std::ios_base::showbase | std::ios_base::showpoint";
+		if(left)
+			piece.flags += " | std::ios_base::left";
+		else if(zero)
+			piece.flags += " | std::ios_base::internal";
+		piece.fill = zero && !left ? '0' : ' ';
+		piece.width = width < 0 ? 0 : width;
+		piece.precision = precision;
+		return true;
+	}
+
+	bool parse(const std::string& literal, std::vector<piece_t>& pieces, size_t& arguments) {
+		std::string text;
+		size_t length = 0, sequential = 0;
+		int positional = 0; // highest %N%
+		for(size_t pos = 0; pos < literal.size();) {
+			const char c = literal[pos];
+			if(c == '\\') {
+				// only simple escapes: a '%' written as \x25 or \045 would be a directive to boost::format
+				if(pos + 1 == literal.size() || isxdigit(static_cast<unsigned char>(literal[pos + 1])) || literal[pos + 1] == 'x' || literal[pos + 1] == 'u' || literal[pos + 1] == 'U')
+					return false;
+				text.append(literal, pos, 2);
+				length++;
+				pos += 2;
+				continue;
+			}
+			if(c != '%') {
+				text += c;
+				length++;
+				pos++;
+				continue;
+			}
+			if(++pos == literal.size())
+				return false;
+			if(literal[pos] == '%') {
+				text += '%';
+				length++;
+				pos++;
+				continue;
+			}
+			if(!text.empty())
+				pieces.push_back(text_piece(text, length));
+			text.clear();
+			length = 0;
+
+			piece_t piece { std::string(), 0, -1, "std::ios_base::skipws | std::ios_base::dec", 0, -1, ' ' };
+			const size_t start = pos;
+			const int n = number(literal, pos);
+			if(n > 0 && pos < literal.size() && literal[pos] == '%') {
+				// %N%
+				piece.argument = n - 1;
+				positional = std::max(positional, n);
+				pos++;
+			} else if(n > 0 && pos < literal.size() && literal[pos] == '$') {
+				// %N$spec
+				piece.argument = n - 1;
+				positional = std::max(positional, n);
+				if(!specification(literal, ++pos, piece))
+					return false;
+			} else {
+				pos = start;
+				piece.argument = sequential++;
+				if(!specification(literal, pos, piece))
+					return false;
+			}
+			pieces.push_back(piece);
+		}
+		if(!text.empty())
+			pieces.push_back(text_piece(text, length));
+		// boost::format does not allow mixing numbered and sequential directives
+		if(positional > 0 && sequential > 0)
+			return false;
+		arguments = positional > 0 ? positional : sequential;
+		return true;
+	}
+
+	std::string escape_html(const std::string& literal, size_t& length) {
+		std::string result;
+		length = 0;
+		for(size_t i = 0; i < literal.size(); ++i) {
+			const char c = literal[i];
+			const char *entity = nullptr;
+			if(c == '\\' && i + 1 < literal.size()) {
+				const char e = literal[++i];
+				if(e == '"')
+					entity = "&quot;";
+				else if(e == '\'')
+					entity = "&#39;";
+				else {
+					result += c;
+					result += e;
+					length++;
+					continue;
+				}
+			} else if(c == '<') {
+				entity = "&lt;";
+			} else if(c == '>') {
+				entity = "&gt;";
+			} else if(c == '&') {
+				entity = "&amp;";
+			} else if(c == '\'') {
+				entity = "&#39;";
+			}
+			if(entity) {
+				result += entity;
+				length += strlen(entity);
+			} else {
+				result += c;
+				length++;
+			}
+		}
+		return result;
+	}
+}}}
@@ -0,0 +1,26 @@
+#ifndef CPPCMS_TEMPLATE_COMPILER_FORMAT_STRING_H
+#define CPPCMS_TEMPLATE_COMPILER_FORMAT_STRING_H
+#include <string>
+#include <vector>
+
+namespace cppcms { namespace templates { namespace format_string {
+	// literal text or one argument of a boost::format string, with the stream state boost::format formats it in
+	struct piece_t {
+		std::string text; // content of a C string literal, as written in the template
+		size_t length; // of text once unescaped
+		int argument; // 0 based, -1 for text
+		std::string flags; // std::ios_base::fmtflags expression
+		int width;
+		int precision; // -1 for the stream default
+		char fill;
+	};
+
+	// splits the content of the string literal of <% format %> / <% rformat %> (without quotes) into pieces;
+	// false when it uses something that is not supported here (%|...|, '*' width, %c, hexadecimal or
+	// octal escapes, ...) and is left to boost::format, arguments is the number of arguments it expects
+	bool parse(const std::string& literal, std::vector<piece_t>& pieces, size_t& arguments);
+
+	// literal content with html special characters replaced by entities, as cppcms::filters::escape does
+	std::string escape_html(const std::string& literal, size_t& length);
+}}}
+#endif
@@ -1,6 +1,37 @@
 #include "generator.h"
 #include <stdexcept>
+#include <algorithm>
+#include <vector>
+#include <sstream>
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+#include <unistd.h>
 namespace cppcms { namespace templates { namespace generator {
+	context::context()
+		: variable_prefix("content.") 
+		, out_stream_uses(0)
+		, split_output(false)
+		, shards(0)
+		, prelude(false)
+		, stream(false)
+		, line_mode(line_mode_t::full)
+		, tracer(nullptr)
+		, sizes(nullptr)
+		, perf_lint(false)
+		, coalesce_text(false)
+		, hoist_out(false)
+		, bind_foreach(false)
+		, fast_escape(false)
+		, compile_format(false)
+		, cache_gt(false)
+		, cache_url(false)
+		, fast_cache(false)
+		, minify(false)
+		, minifier(nullptr)
+		, linter(nullptr)
+		, translator(nullptr) {}
+
 	void context::add_scope_variable(const std::string& name) {
 		if(!scope_variables.insert(name).second)
 			throw std::runtime_error("duplicate local scope variable: " + name);
@@ -19,4 +50,299 @@ namespace cppcms { namespace templates { namespace generator {
 		includes.insert(filename);
 	}
 
+	// absolute, lexically normalized path: no ".", ".." or repeated '/'
+	static std::string normalize_path(const std::string& path) {
+		std::string full = path;
+		if(full.empty() || full[0] != '/') {
+			std::vector<char> cwd(4096);
+			if(!getcwd(cwd.data(), cwd.size()))
+				throw std::runtime_error("unable to get current directory");
+			full = std::string(cwd.data()) + "/" + full;
+		}
+		std::vector<std::string> parts;
+		size_t pos = 0;
+		while(pos <= full.size()) {
+			size_t next = full.find('/', pos);
+			if(next == std::string::npos)
+				next = full.size();
+			const std::string part = full.substr(pos, next - pos);
+			if(part == "..") {
+				if(!parts.empty())
+					parts.pop_back();
+			} else if(!part.empty() && part != ".") {
+				parts.push_back(part);
+			}
+			pos = next + 1;
+		}
+		std::string result;
+		for(const auto& part : parts)
+			result += "/" + part;
+		return result.empty() ? "/" : result;
+	}
+
+	const std::string& context::source_path(const std::string& filename) {
+		if(source_root.empty())
+			return filename;
+		auto i = source_paths.find(filename);
+		if(i == source_paths.end()) {
+			const std::string root = normalize_path(source_root);
+			const std::string path = normalize_path(filename);
+			std::string result = filename;
+			if(root == "/")
+				result = path.substr(1);
+			else if(path.compare(0, root.size(), root) == 0 && path.size() > root.size() && path[root.size()] == '/')
+				result = path.substr(root.size() + 1);
+			i = source_paths.insert(std::make_pair(filename, result)).first;
+		}
+		return i->second;
+	}
+
+	// recursive descent over C++ operator precedence; ok_ turns false on anything that is not constant
+	class constant_evaluator {
+		const std::map<std::string, std::string>& defines_;
+		const std::string& s_;
+		size_t pos_;
+		int depth_;
+		bool ok_;
+
+		void skipws() {
+			while(pos_ < s_.size() && isspace(static_cast<unsigned char>(s_[pos_])))
+				++pos_;
+		}
+		bool take(const char *op) {
+			skipws();
+			const size_t n = strlen(op);
+			if(s_.compare(pos_, n, op) != 0)
+				return false;
+			// single character operators must not match the start of "<=", "==", "&&" or "||"
+			if(n == 1 && pos_ + 1 < s_.size() && (s_[pos_ + 1] == '=' || s_[pos_ + 1] == *op))
+				return false;
+			pos_ += n;
+			return true;
+		}
+		long long fail() { ok_ = false; return 0; }
+
+		long long primary() {
+			skipws();
+			if(!ok_ || pos_ == s_.size())
+				return fail();
+			if(take("(")) {
+				const long long v = logical_or();
+				return take(")") ? v : fail();
+			}
+			const char c = s_[pos_];
+			if(isdigit(static_cast<unsigned char>(c))) {
+				char *end = nullptr;
+				const long long v = strtoll(s_.c_str() + pos_, &end, 0);
+				pos_ = end - s_.c_str();
+				while(pos_ < s_.size() && strchr("uUlL", s_[pos_]))
+					++pos_;
+				return v;
+			}
+			if(isalpha(static_cast<unsigned char>(c)) || c == '_') {
+				const size_t start = pos_;
+				while(pos_ < s_.size() && (isalnum(static_cast<unsigned char>(s_[pos_])) || s_[pos_] == '_'))
+					++pos_;
+				const std::string name = s_.substr(start, pos_ - start);
+				if(name == "true")
+					return 1;
+				if(name == "false")
+					return 0;
+				auto i = defines_.find(name);
+				if(i == defines_.end() || depth_ > 16)
+					return fail();
+				constant_evaluator nested(defines_, i->second, depth_ + 1);
+				long long v = 0;
+				return nested.evaluate(v) ? v : fail();
+			}
+			return fail();
+		}
+		long long unary() {
+			if(take("!")) return !unary();
+			if(take("-")) return -unary();
+			if(take("+")) return unary();
+			return primary();
+		}
+		long long multiplicative() {
+			long long v = unary();
+			for(;;) {
+				if(take("*")) {
+					v *= unary();
+				} else if(take("/") || take("%")) {
+					const bool divide = s_[pos_ - 1] == '/';
+					const long long d = unary();
+					if(d == 0)
+						return fail();
+					v = divide ? v / d : v % d;
+				} else {
+					return v;
+				}
+			}
+		}
+		long long additive() {
+			long long v = multiplicative();
+			for(;;) {
+				if(take("+")) v += multiplicative();
+				else if(take("-")) v -= multiplicative();
+				else return v;
+			}
+		}
+		long long relational() {
+			long long v = additive();
+			for(;;) {
+				if(take("<=")) v = v <= additive();
+				else if(take(">=")) v = v >= additive();
+				else if(take("<")) v = v < additive();
+				else if(take(">")) v = v > additive();
+				else return v;
+			}
+		}
+		long long equality() {
+			long long v = relational();
+			for(;;) {
+				if(take("==")) v = v == relational();
+				else if(take("!=")) v = v != relational();
+				else return v;
+			}
+		}
+		long long logical_and() {
+			long long v = equality();
+			while(take("&&")) {
+				const long long r = equality();
+				v = v && r;
+			}
+			return v;
+		}
+		long long logical_or() {
+			long long v = logical_and();
+			while(take("||")) {
+				const long long r = logical_and();
+				v = v || r;
+			}
+			return v;
+		}
+	public:
+		constant_evaluator(const std::map<std::string, std::string>& defines, const std::string& expression, int depth = 0)
+			: defines_(defines), s_(expression), pos_(0), depth_(depth), ok_(true) {}
+
+		bool evaluate(long long& value) {
+			value = logical_or();
+			skipws();
+			return ok_ && pos_ == s_.size();
+		}
+	};
+
+	bool context::evaluate(const std::string& expression, long long& value) const {
+		return constant_evaluator(defines, expression).evaluate(value);
+	}
+
+	const char *context::out_stream() {
+		if(!hoist_out)
+			return "out()";
+		out_stream_uses++;
+		return "_cppcms_out";
+	}
+
+	const size_t code_writer::chunk_size;
+
+	code_writer::code_writer(std::ostream *sink)
+		: sink_(sink)
+		, size_(0)
+		, known_(false)
+		, line_(0)
+		, newlines_(0) {}
+
+	code_writer& code_writer::write(const char *s, size_t n) {
+		for(const char *p = s, *end = s + n; (p = static_cast<const char*>(memchr(p, '\n', end - p))); ++p)
+			newlines_++;
+		while(n > 0) {
+			if(chunks_.empty() || chunks_.back().size() == chunks_.back().capacity()) {
+				// chunks grow with content up to chunk_size, so short lived writers stay small
+				chunks_.emplace_back();
+				chunks_.back().reserve(std::max(n, std::min(chunk_size, std::max<size_t>(size_, 256))));
+			}
+			std::string& chunk = chunks_.back();
+			const size_t part = std::min(n, chunk.capacity() - chunk.size());
+			chunk.append(s, part);
+			size_ += part;
+			s += part;
+			n -= part;
+		}
+		return *this;
+	}
+
+	code_writer& code_writer::operator<<(const char *s) {
+		return write(s, strlen(s));
+	}
+
+	code_writer& code_writer::operator<<(size_t n) {
+		char buf[24];
+		char *p = buf + sizeof(buf);
+		do {
+			*--p = '0' + n % 10;
+			n /= 10;
+		} while(n);
+		return write(p, buf + sizeof(buf) - p);
+	}
+
+	code_writer& code_writer::operator<<(int n) {
+		if(n < 0) {
+			write("-", 1);
+			return *this << static_cast<size_t>(-static_cast<long long>(n));
+		}
+		return *this << static_cast<size_t>(n);
+	}
+
+	code_writer& code_writer::line(size_t number, const std::string& file, line_mode_t mode) {
+		if(mode == line_mode_t::none)
+			return *this;
+		// short forward jumps in the same file are cheaper as empty lines (as cpp -E does)
+		const size_t next = line_ + newlines_;
+		const bool nearby = known_ && file == file_ && number >= next && number - next <= 8;
+		if(mode == line_mode_t::compressed && nearby)
+			write(std::string(number - next, '\n').data(), number - next);
+		else
+			*this << "#line " << number << " \"" << file << "\"\n";
+		known_ = true;
+		file_ = file;
+		line_ = number;
+		newlines_ = 0;
+		return *this;
+	}
+
+	void code_writer::splice(code_writer& other) {
+		for(std::string& chunk : other.chunks_)
+			chunks_.push_back(std::move(chunk));
+		size_ += other.size_;
+		other.chunks_.clear();
+		other.size_ = 0;
+		// other was written without knowing what precedes it, so it starts with a full #line if it has any
+		if(other.known_) {
+			known_ = true;
+			file_ = other.file_;
+			line_ = other.line_;
+			newlines_ = other.newlines_;
+		} else {
+			newlines_ += other.newlines_;
+		}
+		other.known_ = false;
+		other.line_ = other.newlines_ = 0;
+	}
+
+	std::string code_writer::str() const {
+		std::string result;
+		result.reserve(size_);
+		for(const std::string& chunk : chunks_)
+			result += chunk;
+		return result;
+	}
+
+	void code_writer::flush() {
+		if(sink_) {
+			for(const std::string& chunk : chunks_)
+				sink_->write(chunk.data(), chunk.size());
+		}
+		chunks_.clear();
+		size_ = 0;
+	}
 }}}
@@ -4,8 +4,43 @@
 #include <string>
 #include <set>
 #include <map>
+#include <utility>
+#include <streambuf>
+#include <ostream>
+
+namespace cppcms { namespace templates { namespace trace {
+	class tracer;
+}}}
+
+namespace cppcms { namespace templates { namespace perf_lint {
+	class linter;
+}}}
+
+namespace cppcms { namespace templates { namespace minify {
+	class minifier;
+}}}
+
+namespace cppcms { namespace templates { namespace catalog {
+	class translator;
+}}}
+
+namespace cppcms { namespace templates { namespace size_report {
+	class report;
+}}}
 
 namespace cppcms { namespace templates { namespace generator {
+		// generated file, used when output is split into many translation units
+		struct unit_t {
+			std::string filename;
+			std::string code;
+		};
+
+		enum class line_mode_t {
+			full, // #line before every statement
+			compressed, // #line only where the source position differs from the one compiler assumes
+			none // no #line at all
+		};
+
 		struct context {
 			struct view_t { 
 				const std::string name, data;
@@ -14,6 +49,8 @@ namespace cppcms { namespace templates { namespace generator {
 				std::vector< view_t > views;
 			};
 
+			context();
+
 			std::map<std::string, skin_t> skins;
 			std::string current_skin;
 
@@ -26,12 +63,75 @@ namespace cppcms { namespace templates { namespace generator {
 			void remove_scope_variable(const std::string& name);
 			bool check_scope_variable(const std::string& name);
 			void add_include(const std::string& include);
+			// file name as written in #line directives (relative to source_root when set)
+			const std::string& source_path(const std::string& filename);
+			// value of an integer/boolean expression made only of defines and literals,
+			// false when it depends on anything else
+			bool evaluate(const std::string& expression, long long& value) const;
+			// stream generated statements write to: out(), or with hoist_out the local
+			// reference bound once by the template being written
+			const char *out_stream();
+			size_t out_stream_uses; // of the local reference, counted per template
 
 			// configurables
 			std::string skin;
+			bool split_output;
+			size_t shards; // 0 = one shard per view
+			bool prelude; // split output: all includes and global c++ code in prelude.h, usable as a precompiled header
+			bool stream; // write and release views one by one
+			std::string source_root; // strip from file names in #line, for reproducible output
+			line_mode_t line_mode;
+			trace::tracer *tracer; // optional timeline of compilation, not owned
+			size_report::report *sizes; // optional generated code statistics per view and template, not owned
+			std::map<std::string, std::string> defines; // -D NAME=VALUE, folds if conditions made of them
+			bool perf_lint; // warn about constructs slow at render time
+			bool coalesce_text; // adjacent static text as one out().write(literal, length)
+			bool hoist_out; // out() called once per template
+			bool bind_foreach; // foreach container evaluated once, separator without a per item test
+			bool fast_escape; // <%= x %> escaped by runtime/cppcms_tmpl/escape.h straight into the stream
+			bool compile_format; // format strings of <% format %> / <% rformat %> parsed at compile time
+			bool cache_gt; // <% gt %> / <% ngt %> translations cached per call site by runtime/cppcms_tmpl/translate.h
+			bool cache_url; // <% url %> mapped once per application by runtime/cppcms_tmpl/url.h
+			bool fast_cache; // <% cache %> hits fetched into a per-thread buffer of runtime/cppcms_tmpl/cache.h
+			std::vector<std::pair<std::string, std::string>> locale_catalogs; // language, .mo file: gt / ngt translated at compile time
+			bool minify; // collapse whitespace and drop comments in html/xhtml text
+			minify::minifier *minifier; // set by compile() when minify is on
+			perf_lint::linter *linter; // set by compile() when perf_lint is on
+			catalog::translator *translator; // set by compile() when locale_catalogs are given
+
 		private:
 			std::set<std::string> scope_variables;
+			std::map<std::string, std::string> source_paths;
+
+		};
+
+		// append-only buffer for generated code, kept in reserved chunks so appends never reallocate
+		class code_writer {
+			std::vector<std::string> chunks_;
+			std::ostream *sink_;
+			size_t size_;
+			// source position the compiler assumes for the next line: newlines_ lines after #line line_ "file_"
+			bool known_;
+			std::string file_;
+			size_t line_, newlines_;
+		public:
+			static const size_t chunk_size = 64 * 1024;
+
+			explicit code_writer(std::ostream *sink = nullptr);
+
+			code_writer& write(const char *s, size_t n);
+			code_writer& operator<<(const std::string& s) { return write(s.data(), s.size()); }
+			code_writer& operator<<(const char *s);
+			code_writer& operator<<(char c) { return write(&c, 1); }
+			code_writer& operator<<(int n);
+			code_writer& operator<<(size_t n);
+			// #line number "file" at the start of a line, as mode asks for it
+			code_writer& line(size_t number, const std::string& file, line_mode_t mode);
+			void splice(code_writer& other); // move content of other to the end, other is left empty
 
+			size_t size() const { return size_; }
+			std::string str() const;
+			void flush(); // write content to sink (if any) and clear
 		};
 	}
 }}	
@@ -1,19 +1,62 @@
 #include "parser.h"
+#include "compiler.h"
+#include "trace.h"
+#include "size_report.h"
+#include "alloc_stats.h"
 #include <sstream>
 #include <iostream>
 #include <fstream>
+#include <cerrno>
+#include <cstdlib>
+#include <sys/stat.h>
 
 void usage(const std::string& self) {
-	std::cerr << self << " [--code(default) | --ast | --parse ] [ -s SKIN NAME ] file1.tmpl file2.tmpl ...\n";
+	std::cerr << self << " [--code(default) | --ast | --parse ] [ -s SKIN NAME ] [ --stream ] [ --source-root DIR ] [ --compress-lines | --no-line ] [ --coalesce-text ] [ --hoist-out ] [ --bind-foreach ] [ --fast-escape ] [ --compile-format ] [ --cache-gt ] [ --cache-url ] [ --fast-cache ] [ --locale-catalog LANGUAGE=FILE.mo ]... [ --minify ] [ --trace-out FILE.json ] [ -D NAME[=VALUE] ]... [ --perf-lint ] [ --size-report FILE.json [ --size-symbols NM.txt ] ] [ -o FILE | --split-output DIR [ --shards N ] [ --prelude ] ] file1.tmpl file2.tmpl ...\n";
 	exit(1);
 }
 
+// writes collected trace when main returns
+struct trace_output {
+	std::string filename;
+	cppcms::templates::trace::tracer tracer;
+	~trace_output() {
+		if(filename.empty())
+			return;
+		std::ofstream o(filename);
+		tracer.write(o);
+		if(!o)
+			std::cerr << "ERROR: could not write " << filename << "\n";
+	}
+};
+
+// writes size report when main returns, object sizes from `nm -C -S` output when given
+struct size_report_output {
+	std::string filename, symbols;
+	cppcms::templates::size_report::report report;
+	~size_report_output() {
+		if(filename.empty())
+			return;
+		if(!symbols.empty()) {
+			std::ifstream nm(symbols);
+			if(!nm)
+				std::cerr << "ERROR: could not read " << symbols << "\n";
+			report.add_symbols(nm);
+		}
+		std::ofstream o(filename);
+		report.write(o);
+		if(!o)
+			std::cerr << "ERROR: could not write " << filename << "\n";
+	}
+};
+
 int main(int argc, char **argv) {
 	std::ofstream out_file;
 	std::ostream* out = &std::cout;
 	std::vector<std::string> files;
+	std::string split_dir;
+	trace_output trace;
+	size_report_output sizes;
 	cppcms::templates::generator::context ctx;
-	ctx.variable_prefix = "content."; // TODO: load defaults
 	enum { code, ast, parse } mode = code;
 	bool end_of_options = false;
 	for(int i=1;i<argc;++i) {
@@ -41,6 +84,66 @@ int main(int argc, char **argv) {
 				usage(argv[0]);
 			}
 			i++;		
+		} else if(v == "--stream") {
+			ctx.stream = true;
+		} else if(v == "--size-report" && i + 1 != argc) {
+			sizes.filename = argv[++i];
+			ctx.sizes = &sizes.report;
+		} else if(v == "--size-symbols" && i + 1 != argc) {
+			sizes.symbols = argv[++i];
+		} else if(v == "--coalesce-text") {
+			ctx.coalesce_text = true;
+		} else if(v == "--hoist-out") {
+			ctx.hoist_out = true;
+		} else if(v == "--bind-foreach") {
+			ctx.bind_foreach = true;
+		} else if(v == "--fast-escape") {
+			ctx.fast_escape = true;
+		} else if(v == "--compile-format") {
+			ctx.compile_format = true;
+		} else if(v == "--cache-gt") {
+			ctx.cache_gt = true;
+		} else if(v == "--cache-url") {
+			ctx.cache_url = true;
+		} else if(v == "--fast-cache") {
+			ctx.fast_cache = true;
+		} else if(v == "--locale-catalog" && i + 1 != argc) {
+			const std::string catalog = argv[++i];
+			const size_t eq = catalog.find('=');
+			if(eq == 0 || eq == std::string::npos || eq + 1 == catalog.size())
+				usage(argv[0]);
+			ctx.locale_catalogs.emplace_back(catalog.substr(0, eq), catalog.substr(eq + 1));
+		} else if(v == "--minify") {
+			ctx.minify = true;
+		} else if(v == "--perf-lint") {
+			ctx.perf_lint = true;
+		} else if(v == "--compress-lines") {
+			ctx.line_mode = cppcms::templates::generator::line_mode_t::compressed;
+		} else if(v == "--no-line") {
+			ctx.line_mode = cppcms::templates::generator::line_mode_t::none;
+		} else if(v == "--trace-out" && i + 1 != argc) {
+			trace.filename = argv[++i];
+			ctx.tracer = &trace.tracer;
+		} else if(v == "--source-root" && i + 1 != argc) {
+			ctx.source_root = argv[++i];
+		} else if(v == "--split-output" && i + 1 != argc) {
+			ctx.split_output = true;
+			split_dir = argv[++i];
+		} else if(v == "--shards" && i + 1 != argc) {
+			// a count of at least one, nothing else
+			char *end;
+			const long shards = strtol(argv[++i], &end, 10);
+			if(end == argv[i] || *end != '\0' || shards <= 0)
+				usage(argv[0]);
+			ctx.shards = shards;
+		} else if(v == "--prelude") {
+			ctx.prelude = true;
+		} else if(v.compare(0, 2, "-D") == 0 && (v.size() > 2 || i + 1 != argc)) {
+			const std::string define = v.size() > 2 ? v.substr(2) : argv[++i];
+			const size_t eq = define.find('=');
+			if(eq == 0 || define.empty())
+				usage(argv[0]);
+			ctx.defines[define.substr(0, eq)] = eq == std::string::npos ? "1" : define.substr(eq + 1);
 		} else if(v[0] == '-') {
 			usage(argv[0]);
 		} else {
@@ -48,28 +151,67 @@ int main(int argc, char **argv) {
 		}
 	}
 
-	if(files.empty())
+	if(files.empty() || (!sizes.symbols.empty() && sizes.filename.empty()) || ((ctx.shards > 0 || ctx.prelude) && !ctx.split_output) || (ctx.split_output && out != &std::cout))
 		usage(argv[0]);
 	
+	std::vector<cppcms::templates::source_file_t> sources;
 	try {
-		cppcms::templates::template_parser p(files);
-		p.parse();
-		if(mode == ast) {
-			p.tree()->dump(*out);
-		} else if(mode == code) {
-			p.write(ctx, *out);
-		} else {
-			std::ostringstream oss;
-			p.write(ctx, oss);
-			std::cout << "parse: ok\n";
-		}
-	} catch(const std::logic_error& e) {
-		std::cerr << "logic error(bug): " << e.what() << std::endl;
-		return 2;
+		cppcms::templates::trace::scope s(ctx.tracer, "read", "phase");
+		cppcms::templates::alloc_stats::scope a(cppcms::templates::alloc_stats::phase, "read");
+		sources = cppcms::templates::readfiles(files, ctx.tracer);
 	} catch(const std::runtime_error& e) {
 		std::cerr << e.what() << std::endl;
 		return 3;
 	}
 
-	return 0;
+	if(mode == ast) {
+		try {
+			cppcms::templates::template_parser p(sources);
+			p.parse();
+			for(const cppcms::templates::diagnostic_t& w : p.warnings())
+				std::cerr << w.text << std::endl;
+			p.tree()->dump(*out);
+		} catch(const std::logic_error& e) {
+			std::cerr << "logic error(bug): " << e.what() << std::endl;
+			return 2;
+		} catch(const std::runtime_error& e) {
+			std::cerr << e.what() << std::endl;
+			return 3;
+		}
+		return 0;
+	}
+
+	std::ostringstream oss;
+	const cppcms::templates::compile_result_t result = cppcms::templates::compile(sources, ctx, (mode == code ? *out : oss));
+	int status = 0;
+	for(const cppcms::templates::diagnostic_t& d : result.diagnostics) {
+		std::cerr << d.text << std::endl;
+		if(d.severity == cppcms::templates::diagnostic_t::severity_t::bug)
+			status = 2;
+		else if(d.severity == cppcms::templates::diagnostic_t::severity_t::error && status == 0)
+			status = 3;
+	}
+	if(status == 0 && mode == parse)
+		std::cout << "parse: ok\n";
+	
+	if(status == 0 && mode == code && ctx.split_output) {
+		if(mkdir(split_dir.c_str(), 0777) != 0 && errno != EEXIST) {
+			std::cerr << "ERROR: could not create directory " << split_dir << "\n";
+			return 3;
+		}
+		cppcms::templates::trace::scope s(ctx.tracer, "output", "phase");
+		cppcms::templates::alloc_stats::scope a(cppcms::templates::alloc_stats::phase, "output");
+		for(const cppcms::templates::generator::unit_t& unit : result.units) {
+			const std::string filename = split_dir + "/" + unit.filename;
+			cppcms::templates::trace::scope su(ctx.tracer, unit.filename, "file");
+			su.arg("bytes", unit.code.size());
+			std::ofstream unit_file(filename);
+			if(!(unit_file << unit.code)) {
+				std::cerr << "ERROR: could not write " << filename << "\n";
+				return 3;
+			}
+		}
+	}
+
+	return status;
 }
@@ -0,0 +1,155 @@
+#include "minify.h"
+#include <algorithm>
+#include <cctype>
+
+namespace cppcms { namespace templates { namespace minify {
+	static bool space(char c) {
+		return isspace(static_cast<unsigned char>(c));
+	}
+
+	static bool name_char(char c) {
+		return isalnum(static_cast<unsigned char>(c)) || c == '-' || c == ':';
+	}
+
+	static bool tag_start(char c) {
+		return isalpha(static_cast<unsigned char>(c)) || c == '/' || c == '!' || c == '?';
+	}
+
+	// lower case name of the tag starting at html[pos] == '<', "/name" for closing tags
+	static std::string tag_at(const std::string& html, size_t pos) {
+		std::string name;
+		for(size_t i = pos + 1; i < html.size() && (name_char(html[i]) || (i == pos + 1 && tag_start(html[i]))); ++i)
+			name += static_cast<char>(tolower(static_cast<unsigned char>(html[i])));
+		return name;
+	}
+
+	static size_t find_nocase(const std::string& html, const std::string& what, size_t pos) {
+		auto i = std::search(html.begin() + pos, html.end(), what.begin(), what.end(), [](char a, char b) {
+			return tolower(static_cast<unsigned char>(a)) == b;
+		});
+		return i == html.end() ? std::string::npos : i - html.begin();
+	}
+
+	minifier::minifier() {
+		reset();
+	}
+
+	void minifier::reset() {
+		state_ = state_t::text;
+		quote_ = 0;
+		tag_.clear();
+		raw_.clear();
+		tag_named_ = false;
+	}
+
+	// elements whose surrounding whitespace is not rendered
+	bool minifier::block(const std::string& tag) {
+		static const char *names[] = {
+			"!doctype", "?xml", "html", "head", "body", "title", "meta", "link", "base", "script", "style", "noscript",
+			"div", "p", "h1", "h2", "h3", "h4", "h5", "h6", "ul", "ol", "li", "dl", "dt", "dd", "table", "thead", "tbody",
+			"tfoot", "tr", "td", "th", "caption", "colgroup", "col", "form", "fieldset", "legend", "section", "article",
+			"aside", "header", "footer", "nav", "main", "figure", "figcaption", "blockquote", "pre", "textarea", "hr", "br",
+			"address", "optgroup", "option"
+		};
+		const std::string name = !tag.empty() && tag[0] == '/' ? tag.substr(1) : tag;
+		for(const char *n : names) {
+			if(name == n)
+				return true;
+		}
+		return false;
+	}
+
+	bool minifier::raw(const std::string& tag) {
+		return tag == "pre" || tag == "textarea" || tag == "script" || tag == "style";
+	}
+
+	void minifier::tag_end(std::string& out, bool& after_block) {
+		state_ = state_t::text;
+		after_block = block(tag_);
+		if(raw(tag_) && out.compare(out.size() - std::min<size_t>(out.size(), 2), 2, "/>") != 0) {
+			state_ = state_t::raw;
+			raw_ = "</" + tag_;
+			after_block = false;
+		}
+	}
+
+	std::string minifier::text(const std::string& html) {
+		std::string out;
+		out.reserve(html.size());
+		bool after_block = false; // last written is the end of a block tag
+		size_t i = 0;
+		while(i < html.size()) {
+			const char c = html[i];
+			if(state_ == state_t::raw || state_ == state_t::comment) {
+				const size_t end = state_ == state_t::raw ? find_nocase(html, raw_, i) : html.find("-->", i);
+				if(end == std::string::npos) {
+					out.append(html, i, std::string::npos);
+					break;
+				}
+				const size_t stop = state_ == state_t::raw ? end : end + 3;
+				out.append(html, i, stop - i);
+				state_ = state_t::text;
+				i = stop;
+			} else if(state_ == state_t::quoted) {
+				out += c;
+				if(c == quote_)
+					state_ = state_t::tag;
+				++i;
+			} else if(state_ == state_t::tag) {
+				if(space(c)) {
+					tag_named_ = true;
+					while(i < html.size() && space(html[i]))
+						++i;
+					if(i == html.size() || html[i] != '>')
+						out += ' ';
+					continue;
+				}
+				out += c;
+				++i;
+				if(c == '"' || c == '\'') {
+					quote_ = c;
+					state_ = state_t::quoted;
+				} else if(c == '>') {
+					tag_end(out, after_block);
+				} else if(!tag_named_ && name_char(c)) {
+					tag_ += static_cast<char>(tolower(static_cast<unsigned char>(c)));
+				} else {
+					tag_named_ = true;
+				}
+			} else if(space(c)) {
+				size_t end = i;
+				while(end < html.size() && space(html[end]))
+					++end;
+				// kept as one space, unless next to a block tag or another space
+				const bool before_block = end < html.size() && html[end] == '<' && block(tag_at(html, end));
+				if(!after_block && !before_block && (out.empty() || out.back() != ' '))
+					out += ' ';
+				i = end;
+			} else if(html.compare(i, 4, "<!--") == 0) {
+				const size_t end = html.find("-->", i + 4);
+				const bool conditional = html.compare(i, 5, "<!--[") == 0 || html.compare(i, 6, "<!--<!") == 0;
+				if(end == std::string::npos) {
+					// template output inside the comment: kept as written
+					out.append(html, i, std::string::npos);
+					state_ = state_t::comment;
+					break;
+				}
+				if(conditional)
+					out.append(html, i, end + 3 - i);
+				i = end + 3;
+			} else if(c == '<' && i + 1 < html.size() && tag_start(html[i + 1])) {
+				state_ = state_t::tag;
+				tag_.assign(1, static_cast<char>(tolower(static_cast<unsigned char>(html[i + 1]))));
+				tag_named_ = false;
+				out.append(html, i, 2);
+				after_block = false;
+				i += 2;
+			} else {
+				out += c;
+				after_block = false;
+				++i;
+			}
+		}
+		return out;
+	}
+}}}
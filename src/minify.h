@@ -0,0 +1,30 @@
+#ifndef CPPCMS_TEMPLATE_COMPILER_MINIFY_H
+#define CPPCMS_TEMPLATE_COMPILER_MINIFY_H
+#include <string>
+
+namespace cppcms { namespace templates { namespace minify {
+	// html/xhtml minification of static text, fed by ast text nodes in document order
+	// (context.minifier): collapses whitespace, drops comments, trims whitespace around
+	// block tags; contents of <pre>, <textarea>, <script> and <style> are kept as they are.
+	// Whether we are inside a tag, a comment or such an element carries over from one piece
+	// of text to the next, as template output may stand between them.
+	class minifier {
+		enum class state_t { text, tag, quoted, comment, raw };
+		state_t state_;
+		char quote_;
+		std::string tag_; // name of the tag being read, lower case, "/name" for closing tags
+		std::string raw_; // element whose content is kept, while in raw state
+		bool tag_named_;
+
+		static bool block(const std::string& tag);
+		static bool raw(const std::string& tag);
+		void tag_end(std::string& out, bool& after_block);
+	public:
+		minifier();
+		// new template: nothing is open
+		void reset();
+		// minified piece of static text, which may be preceded and followed by template output
+		std::string text(const std::string& html);
+	};
+}}}
+#endif
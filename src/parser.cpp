@@ -1,4 +1,5 @@
 #include "parser.h"
+#include "trace.h"
 
 #include <algorithm>
 #include <boost/lexical_cast.hpp>
@@ -65,6 +66,10 @@ namespace cppcms { namespace templates {
 		: source_(files)
        		, failed_(0) {}
 	
+	parser::parser(const std::vector<source_file_t>& sources)
+		: source_(sources)
+       		, failed_(0) {}
+	
 	parser& parser::try_token(const std::string& token) {
 #ifdef PARSER_DEBUG
 		std::cout << ">>>(" << failed_ << ") find token '" << token << "' at '" << source_.right_context(20) << "'\n";
@@ -334,7 +339,7 @@ namespace cppcms { namespace templates {
 			source_.mark();
 
 			if(try_name()) {
-				auto try_template_call_list = [this]() {
+				auto try_template_call_list = [this]() -> parser& {
 					if(try_token("<")) {
 						std::string tmp;
 						while(try_identifier().skipws(false).try_one_of_tokens({",", ">"}, tmp)) {
@@ -667,7 +672,7 @@ namespace cppcms { namespace templates {
 		const std::string left = source_.left_context(context);
 		const std::string right = source_.right_context(context);
 		throw parse_error("Parse error at line " + line().filename + ":" + boost::lexical_cast<std::string>(line().line) + ", file offset " +
-				boost::lexical_cast<std::string>(source_.index()) + " near '\n\e[1;32m" + left + "\e[1;31m" + right + "\e[0m': " + msg); 		
+				boost::lexical_cast<std::string>(source_.index()) + " near '\n\e[1;32m" + left + "\e[1;31m" + right + "\e[0m': " + msg, line(), msg); 		
 	}
 
 	void parser::raise_at_line(const file_position_t& file, const std::string& msg) {
@@ -680,7 +685,7 @@ namespace cppcms { namespace templates {
 		const std::string left = source_.left_context(context);
 		const std::string right = source_.right_context(context);		
 		source_.move_to(orig_index);
-		throw parse_error("Error at file " + file.filename + ":" + boost::lexical_cast<std::string>(file.line) + " near '\e[1;32m" + left + "\e[1;31m" + right + "\e[0m': " + msg); 
+		throw parse_error("Error at file " + file.filename + ":" + boost::lexical_cast<std::string>(file.line) + " near '\e[1;32m" + left + "\e[1;31m" + right + "\e[0m': " + msg, file, msg); 
 	}
 
 	bool parser::failed() const {
@@ -777,7 +782,16 @@ namespace cppcms { namespace templates {
 		: p(files) 
 		, tree_(std::make_shared<ast::root_t>()) 
 		, current_(tree_) {}
+	
+	template_parser::template_parser(const std::vector<source_file_t>& sources)
+		: p(sources) 
+		, tree_(std::make_shared<ast::root_t>()) 
+		, current_(tree_) {}
 		
+	const std::vector<diagnostic_t>& template_parser::warnings() const {
+		return warnings_;
+	}
+
 
 	ast::root_ptr template_parser::tree() {
 		return tree_;
@@ -788,7 +802,22 @@ namespace cppcms { namespace templates {
 			context.output_mode = tree()->mode();
 			if(context.output_mode.empty())
 				context.output_mode = "html"; // TODO: context.load_defaults()
-			tree()->write(context, o);
+			generator::code_writer output(&o);
+			tree()->write(context, output);
+			trace::scope s(context.tracer, "output", "phase");
+			s.arg("bytes", output.size());
+			output.flush();
+		} catch(const cppcms::templates::error_at_line& e) {
+			p.raise_at_line(e.line(), e.what());
+		}
+	}
+
+	void template_parser::write_units(generator::context& context, std::vector<generator::unit_t>& units) {
+		try {
+			context.output_mode = tree()->mode();
+			if(context.output_mode.empty())
+				context.output_mode = "html"; // TODO: context.load_defaults()
+			tree()->write_units(context, units);
 		} catch(const cppcms::templates::error_at_line& e) {
 			p.raise_at_line(e.line(), e.what());
 		}
@@ -823,7 +852,9 @@ namespace cppcms { namespace templates {
 							if(!try_variable_expression()) {
 								p.raise("expected c++, global, render or flow expression or (deprecated) variable expression");
 							} else {
-								std::cerr << "WARNING: do not use deprecated variable syntax <% var %> at line " << p.line().filename << ":" << p.line().line << std::endl;
+								const std::string msg = "do not use deprecated variable syntax <% var %>";
+								warnings_.push_back({ diagnostic_t::severity_t::warning, p.line(), msg, 
+									"WARNING: " + msg + " at line " + p.line().filename + ":" + boost::lexical_cast<std::string>(p.line().line) });
 							}
 						} 
 					} else {
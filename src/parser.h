@@ -40,6 +40,7 @@ namespace cppcms { namespace templates {
 	public:
 		file_position_t line() const;
 		explicit parser(const std::vector<std::string>& files);
+		explicit parser(const std::vector<source_file_t>& sources);
 
 		parser& try_token(const std::string& token);
 		parser& try_token_ws(const std::string& token);
@@ -93,15 +94,19 @@ namespace cppcms { namespace templates {
 		parser p;
 		ast::root_ptr tree_;
 		ast::base_ptr current_;
+		std::vector<diagnostic_t> warnings_;
 
 		ast::using_options_t parse_using_options(std::vector<std::string>&);
 	public:
 		template_parser(const std::vector<std::string>& files);
+		template_parser(const std::vector<source_file_t>& sources);
 
 		void parse();
+		const std::vector<diagnostic_t>& warnings() const;
 
 		ast::root_ptr tree();
 		void write(generator::context& context, std::ostream& o);
+		void write_units(generator::context& context, std::vector<generator::unit_t>& units);
 	private:
 		bool try_flow_expression();
 		bool try_global_expression();
@@ -1,4 +1,5 @@
 #include "parser_source.h"
+#include "trace.h"
 
 #include <stdexcept>
 #include <fstream>
@@ -13,13 +14,23 @@ namespace cppcms { namespace templates {
 	}
 	
 
-	std::pair<std::string, std::vector<file_index_t>> readfiles(const std::vector<std::string>& files) {
+	std::vector<source_file_t> readfiles(const std::vector<std::string>& files, trace::tracer *tracer) {
+		std::vector<source_file_t> result;
+		for(const std::string& fn : files) {
+			trace::scope s(tracer, fn, "file");
+			result.push_back(source_file_t { fn, readfile(fn) });
+			s.arg("bytes", result.back().content.size());
+		}
+		return result;
+	}
+
+	static std::pair<std::string, std::vector<file_index_t>> concatenate(const std::vector<source_file_t>& sources) {
 		std::string content;
 		std::vector<file_index_t> indexes;
 		size_t all_lines = 0;
-		for(const std::string& fn : files) {
-			std::string part = readfile(fn);
-			if(part[part.length()-1] != '\n')
+		for(const source_file_t& source : sources) {
+			std::string part = source.content;
+			if(part.empty() || part[part.length()-1] != '\n')
 				part += '\n';
 
 			size_t lines = 0;
@@ -27,7 +38,7 @@ namespace cppcms { namespace templates {
 				if(c == '\n')
 					lines ++;
 
-			indexes.push_back({fn, content.length(), content.length()+part.length(), all_lines, all_lines+lines});
+			indexes.push_back({source.filename, content.length(), content.length()+part.length(), all_lines, all_lines+lines});
 			all_lines += lines;
 			content += part;
 		}
@@ -35,7 +46,10 @@ namespace cppcms { namespace templates {
 	}
 
 	parser_source::parser_source(const std::vector<std::string>& files)
-		: input_pair_(readfiles(files))
+		: parser_source(readfiles(files)) {}
+
+	parser_source::parser_source(const std::vector<source_file_t>& sources)
+		: input_pair_(concatenate(sources))
 		, input_(input_pair_.first)
        		, index_(0)
 		, line_(1) 
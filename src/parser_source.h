@@ -10,6 +10,14 @@ namespace cppcms { namespace templates {
 		size_t line;
 	};
 
+	struct source_file_t {
+		std::string filename;
+		std::string content;
+	};
+
+	namespace trace { class tracer; }
+	std::vector<source_file_t> readfiles(const std::vector<std::string>& files, trace::tracer *tracer = nullptr);
+
 	struct file_index_t {
 		const std::string filename;
 		const size_t beg, end;
@@ -18,12 +26,14 @@ namespace cppcms { namespace templates {
 
 	class parser_source {
 		const std::pair<std::string, std::vector<file_index_t>> input_pair_;
-		const std::string input_;
+		const std::string& input_; // input_pair_.first
 		size_t index_, line_;
 		std::vector<file_index_t> file_indexes_;
 		std::stack< size_t > marks_;
 	public:
 		parser_source(const std::vector<std::string>& files);
+		parser_source(const std::vector<source_file_t>& sources);
+		parser_source(const parser_source&) = delete;
 		void reset(size_t index, file_position_t line);
 
 		void move(int offset); // index_ += index_offset
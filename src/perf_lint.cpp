@@ -0,0 +1,89 @@
+#include "perf_lint.h"
+#include <boost/lexical_cast.hpp>
+#include <cctype>
+
+namespace cppcms { namespace templates { namespace perf_lint {
+	// an accessor chain evaluated this many times in one template is reported
+	static const size_t repeated_accessor = 3;
+
+	linter::linter()
+		: depth_(0) {}
+
+	std::string linter::cost(int depth) {
+		if(depth == 0)
+			return "once per render";
+		if(depth == 1)
+			return "per iteration";
+		return "per iteration of " + boost::lexical_cast<std::string>(depth) + " nested loops";
+	}
+
+	void linter::begin_template(const std::string& name) {
+		template_ = name;
+		accessors_.clear();
+		accessor_order_.clear();
+	}
+
+	void linter::end_template() {
+		for(const std::string& chain : accessor_order_) {
+			const accessor_t& a = accessors_[chain];
+			if(a.count < repeated_accessor)
+				continue;
+			const int saved = depth_;
+			depth_ = a.depth;
+			warn(a.line, "content accessor " + chain + " evaluated " + boost::lexical_cast<std::string>(a.count)
+				+ " times in template " + template_ + ", bind it once");
+			depth_ = saved;
+		}
+		accessors_.clear();
+		accessor_order_.clear();
+	}
+
+	void linter::begin_loop() { depth_++; }
+	void linter::end_loop() { depth_--; }
+	bool linter::in_loop() const { return depth_ > 0; }
+
+	void linter::warn(const file_position_t& line, const std::string& message) {
+		const std::string msg = "perf: " + message + " [cost: " + cost(depth_) + "]";
+		diagnostics_.push_back({ diagnostic_t::severity_t::warning, line, msg,
+			"WARNING: " + msg + " at line " + line.filename + ":" + boost::lexical_cast<std::string>(line.line) });
+	}
+
+	std::string linter::root(const std::string& variable) {
+		size_t begin = 0;
+		while(begin < variable.size() && variable[begin] == '*')
+			++begin;
+		size_t end = begin;
+		while(end < variable.size() && (isalnum(static_cast<unsigned char>(variable[end])) || variable[end] == '_'))
+			++end;
+		return variable.substr(begin, end - begin);
+	}
+
+	void linter::accessor(const file_position_t& line, const std::string& variable, bool local) {
+		// plain members are cheap, chains of members and calls are not
+		if(local || variable.find_first_of(".-(") == std::string::npos)
+			return;
+		auto i = accessors_.find(variable);
+		if(i == accessors_.end()) {
+			accessors_.insert({ variable, accessor_t { line, 1, depth_ } });
+			accessor_order_.push_back(variable);
+		} else {
+			i->second.count++;
+			i->second.depth = std::max(i->second.depth, depth_);
+		}
+	}
+
+	const std::vector<diagnostic_t>& linter::diagnostics() const {
+		return diagnostics_;
+	}
+
+	loop::loop(linter *l)
+		: linter_(l) {
+		if(linter_)
+			linter_->begin_loop();
+	}
+
+	loop::~loop() {
+		if(linter_)
+			linter_->end_loop();
+	}
+}}}
@@ -0,0 +1,52 @@
+#ifndef CPPCMS_TEMPLATE_COMPILER_PERF_LINT_H
+#define CPPCMS_TEMPLATE_COMPILER_PERF_LINT_H
+#include "errors.h"
+#include "parser_source.h"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace cppcms { namespace templates { namespace perf_lint {
+	// collects warnings about constructs known to be slow at render time,
+	// fed by ast nodes while code is generated (context.linter)
+	class linter {
+		struct accessor_t {
+			file_position_t line;
+			size_t count;
+			int depth; // deepest loop it is evaluated in
+		};
+		std::vector<diagnostic_t> diagnostics_;
+		std::string template_;
+		std::map<std::string, accessor_t> accessors_;
+		std::vector<std::string> accessor_order_;
+		int depth_;
+
+		// how often the construct runs: once per render, per iteration, per iteration of nested loops
+		static std::string cost(int depth);
+	public:
+		linter();
+		void begin_template(const std::string& name);
+		// reports content accessor chains evaluated repeatedly in the template
+		void end_template();
+		void begin_loop();
+		void end_loop();
+		bool in_loop() const;
+		void warn(const file_position_t& line, const std::string& message);
+		// variable as written in template, local when it starts with a template parameter or loop variable
+		void accessor(const file_position_t& line, const std::string& variable, bool local);
+		const std::vector<diagnostic_t>& diagnostics() const;
+
+		// first name of a variable: "user" of "*user.name()"
+		static std::string root(const std::string& variable);
+	};
+
+	// loop body, does nothing without linter
+	class loop {
+		linter *linter_;
+	public:
+		explicit loop(linter *l);
+		loop(const loop&) = delete;
+		~loop();
+	};
+}}}
+#endif
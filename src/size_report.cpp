@@ -0,0 +1,227 @@
+#include "size_report.h"
+#include "trace.h"
+#include <sstream>
+
+namespace cppcms { namespace templates { namespace size_report {
+	static const size_t npos = static_cast<size_t>(-1);
+
+	counts_t::counts_t()
+		: bytes(0), line_directives(0), literal_bytes(0), expressions(0), object_bytes(0) {}
+
+	counts_t& counts_t::operator+=(const counts_t& rhs) {
+		bytes += rhs.bytes;
+		line_directives += rhs.line_directives;
+		literal_bytes += rhs.literal_bytes;
+		expressions += rhs.expressions;
+		object_bytes += rhs.object_bytes;
+		return *this;
+	}
+
+	counts_t report::view_t::total() const {
+		counts_t result = counts;
+		for(const template_t& t : templates)
+			result += t.counts;
+		return result;
+	}
+
+	report::report()
+		: view_(npos)
+		, template_(npos)
+		, template_bytes_(0)
+		, unmapped_object_bytes_(0)
+		, has_symbols_(false) {}
+
+	size_t report::template_bytes() const {
+		size_t bytes = 0;
+		for(const template_t& t : views_[view_].templates)
+			bytes += t.counts.bytes;
+		return bytes;
+	}
+
+	void report::begin_view(const std::string& skin, const std::string& name, const file_position_t& line) {
+		const std::string key = skin + "::" + name;
+		auto i = view_index_.find(key);
+		if(i == view_index_.end()) {
+			i = view_index_.insert(std::make_pair(key, views_.size())).first;
+			views_.push_back(view_t { skin, name, line, counts_t(), std::vector<template_t>() });
+		}
+		view_ = i->second;
+		template_bytes_ = template_bytes();
+	}
+
+	void report::end_view(size_t bytes) {
+		// bytes written for the view include its templates, which counted their own
+		views_[view_].counts.bytes += bytes - (template_bytes() - template_bytes_);
+		view_ = npos;
+	}
+
+	void report::begin_template(const std::string& name, const std::string& signature, size_t arguments, const file_position_t& line) {
+		if(view_ == npos)
+			return;
+		std::vector<template_t>& templates = views_[view_].templates;
+		for(template_ = 0; template_ < templates.size() && templates[template_].signature != signature; ++template_) {}
+		if(template_ == templates.size())
+			templates.push_back(template_t { name, signature, arguments, line, counts_t() });
+	}
+
+	void report::end_template(size_t bytes) {
+		if(view_ == npos || template_ == npos)
+			return;
+		views_[view_].templates[template_].counts.bytes += bytes;
+		template_ = npos;
+	}
+
+	counts_t& report::current() {
+		if(view_ == npos)
+			return outside_;
+		if(template_ == npos)
+			return views_[view_].counts;
+		return views_[view_].templates[template_].counts;
+	}
+
+	void report::line_directive() {
+		current().line_directives++;
+	}
+
+	void report::literal(size_t bytes) {
+		current().literal_bytes += bytes;
+	}
+
+	void report::expression() {
+		current().expressions++;
+	}
+
+	// "skin::view::template" of a demangled symbol, without arguments and template arguments
+	static std::string symbol_path(std::string name) {
+		static const char *prefixes[] = { "vtable for ", "typeinfo for ", "typeinfo name for ", "non-virtual thunk to ", "virtual thunk to " };
+		for(const char *prefix : prefixes) {
+			const std::string p(prefix);
+			if(name.compare(0, p.size(), p) == 0)
+				name = name.substr(p.size());
+		}
+		const size_t paren = name.find('(');
+		if(paren != std::string::npos)
+			name = name.substr(0, paren);
+		if(!name.empty() && name.back() == '>') {
+			int depth = 0;
+			for(size_t i = name.size(); i-- > 0;) {
+				if(name[i] == '>') {
+					depth++;
+				} else if(name[i] == '<' && --depth == 0) {
+					name = name.substr(0, i);
+					break;
+				}
+			}
+		}
+		return name;
+	}
+
+	// number of arguments of a demangled function symbol, npos when it is not a function
+	static size_t symbol_arguments(const std::string& name) {
+		const size_t paren = name.find('(');
+		if(paren == std::string::npos)
+			return npos;
+		size_t arguments = 0;
+		int depth = 0;
+		for(size_t i = paren + 1; i < name.size(); ++i) {
+			const char c = name[i];
+			if(c == '(' || c == '<' || c == '[') {
+				depth++;
+			} else if(c == ')' || c == '>' || c == ']') {
+				if(depth-- == 0)
+					break;
+			} else if(depth == 0 && arguments == 0 && c != ' ') {
+				arguments = 1;
+			}
+			if(c == ',' && depth == 0)
+				arguments++;
+		}
+		return arguments;
+	}
+
+	size_t report::add_symbols(std::istream& nm) {
+		has_symbols_ = true;
+		size_t unmapped = 0;
+		std::string line;
+		while(std::getline(nm, line)) {
+			// ADDRESS SIZE TYPE NAME, symbols without size have no SIZE column
+			std::istringstream ss(line);
+			std::string address, size, type, name;
+			if(!(ss >> address >> size >> type) || type.size() != 1 || !std::getline(ss >> std::ws, name))
+				continue;
+			const size_t bytes = std::stoull(size, nullptr, 16);
+			const std::string path = symbol_path(name);
+			auto view = view_index_.find(path);
+			if(view != view_index_.end()) {
+				views_[view->second].counts.object_bytes += bytes;
+				continue;
+			}
+			const size_t sep = path.rfind("::");
+			if(sep == std::string::npos || (view = view_index_.find(path.substr(0, sep))) == view_index_.end()) {
+				unmapped += bytes;
+				continue;
+			}
+			view_t& v = views_[view->second];
+			const std::string member = path.substr(sep + 2);
+			counts_t *counts = &v.counts; // constructor, destructor and other members
+			// overloads are told apart by their number of arguments only
+			const size_t arguments = symbol_arguments(name);
+			for(template_t& t : v.templates) {
+				if(t.name == member && (counts == &v.counts || t.arguments == arguments))
+					counts = &t.counts;
+			}
+			counts->object_bytes += bytes;
+		}
+		unmapped_object_bytes_ += unmapped;
+		return unmapped;
+	}
+
+	static void write_counts(std::ostream& o, const counts_t& c, bool objects) {
+		o << "\"bytes\":" << c.bytes << ",\"line_directives\":" << c.line_directives
+			<< ",\"literal_bytes\":" << c.literal_bytes << ",\"expressions\":" << c.expressions;
+		if(objects)
+			o << ",\"object_bytes\":" << c.object_bytes;
+	}
+
+	void report::write(std::ostream& o) const {
+		counts_t total;
+		o << "{\"views\":[\n";
+		for(auto v = views_.begin(); v != views_.end(); ++v) {
+			if(v != views_.begin())
+				o << ",\n";
+			const counts_t view_total = v->total();
+			total += view_total;
+			o << "{\"skin\":";
+			trace::write_json_string(o, v->skin);
+			o << ",\"view\":";
+			trace::write_json_string(o, v->name);
+			o << ",\"file\":";
+			trace::write_json_string(o, v->line.filename);
+			o << ",\"line\":" << v->line.line << ",";
+			write_counts(o, view_total, has_symbols_);
+			o << ",\"templates\":[";
+			for(auto t = v->templates.begin(); t != v->templates.end(); ++t) {
+				if(t != v->templates.begin())
+					o << ",";
+				o << "\n\t{\"name\":";
+				trace::write_json_string(o, t->name);
+				o << ",\"signature\":";
+				trace::write_json_string(o, t->signature);
+				o << ",\"line\":" << t->line.line << ",";
+				write_counts(o, t->counts, has_symbols_);
+				o << "}";
+			}
+			o << "]}";
+		}
+		o << "\n],\"total\":{";
+		write_counts(o, total, has_symbols_);
+		o << "}";
+		if(has_symbols_)
+			o << ",\"unmapped_object_bytes\":" << unmapped_object_bytes_;
+		o << "}\n";
+	}
+
+	const std::vector<report::view_t>& report::views() const {
+		return views_;
+	}
+}}}
@@ -0,0 +1,65 @@
+#ifndef CPPCMS_TEMPLATE_COMPILER_SIZE_REPORT_H
+#define CPPCMS_TEMPLATE_COMPILER_SIZE_REPORT_H
+#include "parser_source.h"
+#include <istream>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace cppcms { namespace templates { namespace size_report {
+	struct counts_t {
+		size_t bytes; // generated C++
+		size_t line_directives; // source positions marked, one #line each in the default line mode
+		size_t literal_bytes; // static text written by the template
+		size_t expressions; // variables, gt/format/url, includes and renders
+		size_t object_bytes; // from object file symbols, see report::add_symbols
+		counts_t();
+		counts_t& operator+=(const counts_t& rhs);
+	};
+
+	// generated code statistics per view and template, written as JSON
+	class report {
+	public:
+		struct template_t {
+			std::string name, signature; // signature: name and arguments, tells overloads apart
+			size_t arguments;
+			file_position_t line;
+			counts_t counts;
+		};
+		struct view_t {
+			std::string skin, name;
+			file_position_t line;
+			counts_t counts; // class head, constructor and anything outside templates
+			std::vector<template_t> templates;
+			counts_t total() const;
+		};
+
+		report();
+		// views and templates may be visited more than once (declarations and definitions in split output)
+		void begin_view(const std::string& skin, const std::string& name, const file_position_t& line);
+		void end_view(size_t bytes);
+		void begin_template(const std::string& name, const std::string& signature, size_t arguments, const file_position_t& line);
+		void end_template(size_t bytes);
+		void line_directive();
+		void literal(size_t bytes);
+		void expression();
+		// reads `nm -C -S` output of objects built from generated code, symbols of views and their
+		// templates are added to object_bytes; returns size of symbols that are not generated views
+		size_t add_symbols(std::istream& nm);
+		void write(std::ostream& o) const;
+		const std::vector<view_t>& views() const;
+	private:
+		counts_t& current();
+		size_t template_bytes() const; // of the current view
+
+		std::vector<view_t> views_;
+		std::map<std::string, size_t> view_index_; // "skin::view"
+		size_t view_, template_; // npos when outside
+		size_t template_bytes_; // of the current view when it was entered
+		counts_t outside_; // loader and includes, not reported
+		size_t unmapped_object_bytes_;
+		bool has_symbols_;
+	};
+}}}
+#endif
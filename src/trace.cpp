@@ -0,0 +1,65 @@
+#include "trace.h"
+
+namespace cppcms { namespace templates { namespace trace {
+	tracer::tracer()
+		: start_(std::chrono::steady_clock::now()) {}
+
+	long long tracer::now() const {
+		return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_).count();
+	}
+
+	void tracer::add(const std::string& name, const std::string& category, long long begin, long long end, const args_t& args) {
+		events_.push_back(event_t { name, category, begin, end - begin, args });
+	}
+
+	void write_json_string(std::ostream& o, const std::string& s) {
+		static const char hex[] = "0123456789abcdef";
+		o << '"';
+		for(const char c : s) {
+			if(c == '"' || c == '\\')
+				o << '\\' << c;
+			else if(static_cast<unsigned char>(c) < 0x20)
+				o << "\\u00" << hex[(c >> 4) & 0xf] << hex[c & 0xf];
+			else
+				o << c;
+		}
+		o << '"';
+	}
+
+	void tracer::write(std::ostream& o) const {
+		o << "{\"traceEvents\":[\n";
+		for(auto e = events_.begin(); e != events_.end(); ++e) {
+			if(e != events_.begin())
+				o << ",\n";
+			o << "{\"name\":";
+			write_json_string(o, e->name);
+			o << ",\"cat\":";
+			write_json_string(o, e->category);
+			o << ",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << e->begin << ",\"dur\":" << e->duration << ",\"args\":{";
+			for(auto a = e->args.begin(); a != e->args.end(); ++a) {
+				if(a != e->args.begin())
+					o << ",";
+				write_json_string(o, a->first);
+				o << ":" << a->second;
+			}
+			o << "}}";
+		}
+		o << "\n],\"displayTimeUnit\":\"ms\"}\n";
+	}
+
+	scope::scope(tracer *t, const std::string& name, const std::string& category)
+		: tracer_(t)
+		, name_(t ? name : std::string())
+		, category_(t ? category : std::string())
+		, begin_(t ? t->now() : 0) {}
+
+	void scope::arg(const std::string& name, size_t value) {
+		if(tracer_)
+			args_.emplace_back(name, value);
+	}
+
+	scope::~scope() {
+		if(tracer_)
+			tracer_->add(name_, category_, begin_, tracer_->now(), args_);
+	}
+}}}
@@ -0,0 +1,46 @@
+#ifndef CPPCMS_TEMPLATE_COMPILER_TRACE_H
+#define CPPCMS_TEMPLATE_COMPILER_TRACE_H
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <utility>
+
+namespace cppcms { namespace templates { namespace trace {
+	// collects timeline of compilation, written in chrome trace-event format
+	// (chrome://tracing, ui.perfetto.dev)
+	class tracer {
+	public:
+		typedef std::vector< std::pair<std::string, size_t> > args_t;
+		struct event_t {
+			std::string name, category;
+			long long begin, duration; // microseconds
+			args_t args;
+		};
+
+		tracer();
+		long long now() const; // microseconds since tracer was created
+		void add(const std::string& name, const std::string& category, long long begin, long long end, const args_t& args);
+		void write(std::ostream& o) const;
+	private:
+		const std::chrono::steady_clock::time_point start_;
+		std::vector<event_t> events_;
+	};
+
+	// s as a JSON string, quotes included
+	void write_json_string(std::ostream& o, const std::string& s);
+
+	// records its lifetime as one event, does nothing without tracer
+	class scope {
+		tracer *tracer_;
+		const std::string name_, category_;
+		const long long begin_;
+		tracer::args_t args_;
+	public:
+		scope(tracer *t, const std::string& name, const std::string& category);
+		scope(const scope&) = delete;
+		void arg(const std::string& name, size_t value);
+		~scope();
+	};
+}}}
+#endif
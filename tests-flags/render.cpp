@@ -0,0 +1,36 @@
+// renders every view of GENERATED, code generated from a tests-flags template, against the cppcms stub
+// of bench/stub: in no language, the languages of the test catalogs and one without a catalog (fr),
+// for the counts whose plural forms differ in them; fr is rendered by another application, mounted elsewhere,
+// and every language sets the lang value of the url mappers
+#include "cppcms_stub.h"
+#include "bench_data.h"
+#include "cppcms_tmpl/url.h"
+#include GENERATED
+#include <iostream>
+
+int main() {
+	cppcms::application app, mounted;
+	mounted.mapper().root("/mounted");
+	bench_data::page page;
+	page.title = "<Title> & \"more\"";
+	page.user.name = "Jane O'Neil";
+	page.logged_in = true;
+	page.items = { { "first", "/a?b=1&c=2", "first <item>", true }, { "second & last", "/b", "", false } };
+	for(const char *language : { "", "de", "ru", "fr" }) {
+		page.app(std::string(language) == "fr" ? mounted : app);
+		cppcms_tmpl::set_url_value(app.mapper(), "lang", language);
+		cppcms_tmpl::set_url_value(mounted.mapper(), "lang", language);
+		for(int count : { 0, 1, 3, 5, 11, 21, 22 }) {
+			page.count = count;
+			std::ostringstream out;
+			if(*language)
+				out.imbue(std::locale(std::locale::classic(), new cppcms::locale::info(language, "XX")));
+			for(const cppcms::views::generator *g : cppcms::views::pool::instance().generators()) {
+				for(const cppcms::views::generator::entry_t& e : g->entries())
+					e.create(out, page)->render();
+			}
+			std::cout << "[" << language << " " << count << "]" << out.str() << "\n";
+		}
+	}
+	return 0;
+}
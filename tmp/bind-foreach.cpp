@@ -0,0 +1,139 @@
+#line 1 "tests-flags/bind-foreach.tmpl"
+#include "bench_data.h" 
+#line 2 "tests-flags/bind-foreach.tmpl"
+namespace bind_foreach {
+#line 3 "tests-flags/bind-foreach.tmpl"
+struct page:public cppcms::base_view
+#line 3 "tests-flags/bind-foreach.tmpl"
+ {
+#line 3 "tests-flags/bind-foreach.tmpl"
+bench_data::page & content;
+#line 3 "tests-flags/bind-foreach.tmpl"
+page(std::ostream & _s, bench_data::page & _content):cppcms::base_view(_s),content(_content)
+#line 3 "tests-flags/bind-foreach.tmpl"
+{
+#line 3 "tests-flags/bind-foreach.tmpl"
+}
+#line 4 "tests-flags/bind-foreach.tmpl"
+virtual void render(){
+#line 5 "tests-flags/bind-foreach.tmpl"
+out() << "\n";
+#line 5 "tests-flags/bind-foreach.tmpl"
+{ auto && it_range = (content.items);
+#line 5 "tests-flags/bind-foreach.tmpl"
+if(it_range.begin() != it_range.end()) {
+#line 5 "tests-flags/bind-foreach.tmpl"
+int i = 1;
+#line 5 "tests-flags/bind-foreach.tmpl"
+out() << "<ul>";
+#line 5 "tests-flags/bind-foreach.tmpl"
+for (CPPCMS_TYPEOF(it_range.begin()) it_ptr = it_range.begin(), it_ptr_end = it_range.end(), it_ptr_first = it_ptr; it_ptr != it_ptr_end; ++it_ptr, ++i) {
+#line 5 "tests-flags/bind-foreach.tmpl"
+CPPCMS_TYPEOF(*it_ptr) & it = *it_ptr;
+#line 5 "tests-flags/bind-foreach.tmpl"
+if(it_ptr != it_ptr_first) {
+#line 5 "tests-flags/bind-foreach.tmpl"
+out() << ", ";
+#line 5 "tests-flags/bind-foreach.tmpl"
+} // end of separator
+#line 5 "tests-flags/bind-foreach.tmpl"
+out() << "<li>";
+#line 5 "tests-flags/bind-foreach.tmpl"
+out() << cppcms::filters::escape(i);
+#line 5 "tests-flags/bind-foreach.tmpl"
+out() << " ";
+#line 5 "tests-flags/bind-foreach.tmpl"
+out() << cppcms::filters::escape(it.title);
+#line 5 "tests-flags/bind-foreach.tmpl"
+out() << "</li>";
+#line 5 "tests-flags/bind-foreach.tmpl"
+} // end of item
+#line 5 "tests-flags/bind-foreach.tmpl"
+out() << "</ul>";
+#line 5 "tests-flags/bind-foreach.tmpl"
+} else {
+#line 5 "tests-flags/bind-foreach.tmpl"
+out() << "<p>none</p>";
+#line 5 "tests-flags/bind-foreach.tmpl"
+} // end of empty
+#line 5 "tests-flags/bind-foreach.tmpl"
+} // end of foreach
+#line 6 "tests-flags/bind-foreach.tmpl"
+out() << "\n";
+#line 6 "tests-flags/bind-foreach.tmpl"
+{ auto && it_range = (content.items);
+#line 6 "tests-flags/bind-foreach.tmpl"
+if(it_range.begin() != it_range.end()) {
+#line 6 "tests-flags/bind-foreach.tmpl"
+for (CPPCMS_TYPEOF(it_range.begin()) it_ptr = it_range.begin(), it_ptr_end = it_range.end(); it_ptr != it_ptr_end; ++it_ptr) {
+#line 6 "tests-flags/bind-foreach.tmpl"
+CPPCMS_TYPEOF(*it_ptr) & it = *it_ptr;
+#line 6 "tests-flags/bind-foreach.tmpl"
+out() << "[";
+#line 6 "tests-flags/bind-foreach.tmpl"
+out() << cppcms::filters::escape(it.url);
+#line 6 "tests-flags/bind-foreach.tmpl"
+out() << "]";
+#line 6 "tests-flags/bind-foreach.tmpl"
+} // end of item
+#line 6 "tests-flags/bind-foreach.tmpl"
+}
+#line 6 "tests-flags/bind-foreach.tmpl"
+} // end of foreach
+#line 7 "tests-flags/bind-foreach.tmpl"
+out() << "\n";
+#line 7 "tests-flags/bind-foreach.tmpl"
+{ auto && it_range = (content.items);
+#line 7 "tests-flags/bind-foreach.tmpl"
+if(it_range.begin() != it_range.end()) {
+#line 7 "tests-flags/bind-foreach.tmpl"
+for (CPPCMS_TYPEOF(it_range.begin()) it_ptr = it_range.begin(), it_ptr_end = it_range.end(), it_ptr_first = it_ptr; it_ptr != it_ptr_end; ++it_ptr) {
+#line 7 "tests-flags/bind-foreach.tmpl"
+CPPCMS_TYPEOF(*it_ptr) & it = *it_ptr;
+#line 7 "tests-flags/bind-foreach.tmpl"
+if(it_ptr != it_ptr_first) {
+#line 7 "tests-flags/bind-foreach.tmpl"
+out() << " | ";
+#line 7 "tests-flags/bind-foreach.tmpl"
+} // end of separator
+#line 7 "tests-flags/bind-foreach.tmpl"
+if(it.summary.empty()) continue; 
+#line 7 "tests-flags/bind-foreach.tmpl"
+out() << cppcms::filters::escape(it.summary);
+#line 7 "tests-flags/bind-foreach.tmpl"
+} // end of item
+#line 7 "tests-flags/bind-foreach.tmpl"
+}
+#line 7 "tests-flags/bind-foreach.tmpl"
+} // end of foreach
+#line 8 "tests-flags/bind-foreach.tmpl"
+out() << "\n";
+#line 8 "tests-flags/bind-foreach.tmpl"
+} // end of template render
+#line 9 "tests-flags/bind-foreach.tmpl"
+}; // end of class page
+#line 10 "tests-flags/bind-foreach.tmpl"
+} // end of namespace bind_foreach
+
+#line 11 "tests-flags/bind-foreach.tmpl"
+namespace {
+#line 11 "tests-flags/bind-foreach.tmpl"
+cppcms::views::generator my_generator;
+#line 11 "tests-flags/bind-foreach.tmpl"
+struct loader {
+#line 11 "tests-flags/bind-foreach.tmpl"
+loader() {
+#line 11 "tests-flags/bind-foreach.tmpl"
+my_generator.name("bind_foreach");
+#line 11 "tests-flags/bind-foreach.tmpl"
+my_generator.add_view< bind_foreach::page, bench_data::page >("page", true);
+#line 11 "tests-flags/bind-foreach.tmpl"
+cppcms::views::pool::instance().add(my_generator);
+#line 11 "tests-flags/bind-foreach.tmpl"
+}
+#line 11 "tests-flags/bind-foreach.tmpl"
+~loader() { cppcms::views::pool::instance().remove(my_generator); }
+#line 11 "tests-flags/bind-foreach.tmpl"
+} a_loader;
+#line 11 "tests-flags/bind-foreach.tmpl"
+} // anon 
@@ -0,0 +1,65 @@
+#line 1 "tests-flags/cache-gt.tmpl"
+#include "bench_data.h" 
+#line 2 "tests-flags/cache-gt.tmpl"
+namespace cache_gt {
+#line 3 "tests-flags/cache-gt.tmpl"
+struct page:public cppcms::base_view
+#line 3 "tests-flags/cache-gt.tmpl"
+ {
+#line 3 "tests-flags/cache-gt.tmpl"
+bench_data::page & content;
+#line 3 "tests-flags/cache-gt.tmpl"
+page(std::ostream & _s, bench_data::page & _content):cppcms::base_view(_s),content(_content)
+#line 3 "tests-flags/cache-gt.tmpl"
+{
+#line 3 "tests-flags/cache-gt.tmpl"
+}
+#line 4 "tests-flags/cache-gt.tmpl"
+virtual void render(){
+#line 5 "tests-flags/cache-gt.tmpl"
+out() << "\n<p>";
+#line 5 "tests-flags/cache-gt.tmpl"
+out() << cppcms::locale::translate("hello");
+#line 5 "tests-flags/cache-gt.tmpl"
+out() << " ";
+#line 5 "tests-flags/cache-gt.tmpl"
+out() << cppcms::locale::format(cppcms::locale::translate("hi {1}"))  % (cppcms::filters::escape(content.title));
+#line 5 "tests-flags/cache-gt.tmpl"
+out() << " ";
+#line 5 "tests-flags/cache-gt.tmpl"
+out() << cppcms::locale::format(cppcms::locale::translate("one item", "{1} items", content.count))  % (cppcms::filters::escape(content.count));
+#line 5 "tests-flags/cache-gt.tmpl"
+out() << " ";
+#line 5 "tests-flags/cache-gt.tmpl"
+out() << cppcms::locale::translate("one", "many", content.count);
+#line 6 "tests-flags/cache-gt.tmpl"
+out() << "</p>\n";
+#line 6 "tests-flags/cache-gt.tmpl"
+} // end of template render
+#line 7 "tests-flags/cache-gt.tmpl"
+}; // end of class page
+#line 8 "tests-flags/cache-gt.tmpl"
+} // end of namespace cache_gt
+
+#line 9 "tests-flags/cache-gt.tmpl"
+namespace {
+#line 9 "tests-flags/cache-gt.tmpl"
+cppcms::views::generator my_generator;
+#line 9 "tests-flags/cache-gt.tmpl"
+struct loader {
+#line 9 "tests-flags/cache-gt.tmpl"
+loader() {
+#line 9 "tests-flags/cache-gt.tmpl"
+my_generator.name("cache_gt");
+#line 9 "tests-flags/cache-gt.tmpl"
+my_generator.add_view< cache_gt::page, bench_data::page >("page", true);
+#line 9 "tests-flags/cache-gt.tmpl"
+cppcms::views::pool::instance().add(my_generator);
+#line 9 "tests-flags/cache-gt.tmpl"
+}
+#line 9 "tests-flags/cache-gt.tmpl"
+~loader() { cppcms::views::pool::instance().remove(my_generator); }
+#line 9 "tests-flags/cache-gt.tmpl"
+} a_loader;
+#line 9 "tests-flags/cache-gt.tmpl"
+} // anon 
@@ -0,0 +1,79 @@
+#line 1 "tests-flags/cache-url.tmpl"
+#include "bench_data.h" 
+#line 2 "tests-flags/cache-url.tmpl"
+namespace cache_url {
+#line 3 "tests-flags/cache-url.tmpl"
+struct page:public cppcms::base_view
+#line 3 "tests-flags/cache-url.tmpl"
+ {
+#line 3 "tests-flags/cache-url.tmpl"
+bench_data::page & content;
+#line 3 "tests-flags/cache-url.tmpl"
+page(std::ostream & _s, bench_data::page & _content):cppcms::base_view(_s),content(_content)
+#line 3 "tests-flags/cache-url.tmpl"
+{
+#line 3 "tests-flags/cache-url.tmpl"
+}
+#line 4 "tests-flags/cache-url.tmpl"
+virtual void render(){
+#line 5 "tests-flags/cache-url.tmpl"
+out() << "\n<a href=\"";
+#line 5 "tests-flags/cache-url.tmpl"
+content.app().mapper().map(out(), "/blog/summary");
+#line 5 "tests-flags/cache-url.tmpl"
+out() << "\">blog</a> <a href=\"";
+#line 5 "tests-flags/cache-url.tmpl"
+content.app().mapper().map(out(), "/home");
+#line 6 "tests-flags/cache-url.tmpl"
+out() << "\">home</a>\n";
+#line 6 "tests-flags/cache-url.tmpl"
+if((content.items).begin() != (content.items).end()) {
+#line 6 "tests-flags/cache-url.tmpl"
+for (CPPCMS_TYPEOF((content.items).begin()) it_ptr = (content.items).begin(), it_ptr_end = (content.items).end(); it_ptr != it_ptr_end; ++it_ptr) {
+#line 6 "tests-flags/cache-url.tmpl"
+CPPCMS_TYPEOF(*it_ptr) & it = *it_ptr;
+#line 6 "tests-flags/cache-url.tmpl"
+out() << "<a href=\"";
+#line 6 "tests-flags/cache-url.tmpl"
+content.app().mapper().map(out(), "/item", cppcms::filters::urlencode(it.title));
+#line 6 "tests-flags/cache-url.tmpl"
+out() << "\">";
+#line 6 "tests-flags/cache-url.tmpl"
+content.app().mapper().map(out(), "/other", cppcms::filters::urlencode(it.title), cppcms::filters::urlencode(content.count));
+#line 6 "tests-flags/cache-url.tmpl"
+out() << "</a>";
+#line 6 "tests-flags/cache-url.tmpl"
+} // end of item
+#line 6 "tests-flags/cache-url.tmpl"
+}
+#line 7 "tests-flags/cache-url.tmpl"
+out() << "\n";
+#line 7 "tests-flags/cache-url.tmpl"
+} // end of template render
+#line 8 "tests-flags/cache-url.tmpl"
+}; // end of class page
+#line 9 "tests-flags/cache-url.tmpl"
+} // end of namespace cache_url
+
+#line 10 "tests-flags/cache-url.tmpl"
+namespace {
+#line 10 "tests-flags/cache-url.tmpl"
+cppcms::views::generator my_generator;
+#line 10 "tests-flags/cache-url.tmpl"
+struct loader {
+#line 10 "tests-flags/cache-url.tmpl"
+loader() {
+#line 10 "tests-flags/cache-url.tmpl"
+my_generator.name("cache_url");
+#line 10 "tests-flags/cache-url.tmpl"
+my_generator.add_view< cache_url::page, bench_data::page >("page", true);
+#line 10 "tests-flags/cache-url.tmpl"
+cppcms::views::pool::instance().add(my_generator);
+#line 10 "tests-flags/cache-url.tmpl"
+}
+#line 10 "tests-flags/cache-url.tmpl"
+~loader() { cppcms::views::pool::instance().remove(my_generator); }
+#line 10 "tests-flags/cache-url.tmpl"
+} a_loader;
+#line 10 "tests-flags/cache-url.tmpl"
+} // anon 
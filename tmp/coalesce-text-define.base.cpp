@@ -0,0 +1,69 @@
+#line 1 "tests-flags/coalesce-text-define.tmpl"
+#include "bench_data.h" 
+#line 2 "tests-flags/coalesce-text-define.tmpl"
+namespace coalesce_text_define {
+#line 3 "tests-flags/coalesce-text-define.tmpl"
+struct page:public cppcms::base_view
+#line 3 "tests-flags/coalesce-text-define.tmpl"
+ {
+#line 3 "tests-flags/coalesce-text-define.tmpl"
+bench_data::page & content;
+#line 3 "tests-flags/coalesce-text-define.tmpl"
+page(std::ostream & _s, bench_data::page & _content):cppcms::base_view(_s),content(_content)
+#line 3 "tests-flags/coalesce-text-define.tmpl"
+{
+#line 3 "tests-flags/coalesce-text-define.tmpl"
+}
+#line 4 "tests-flags/coalesce-text-define.tmpl"
+virtual void render(){
+#line 6 "tests-flags/coalesce-text-define.tmpl"
+out() << "\n<p>header</p>\n";
+#line 6 "tests-flags/coalesce-text-define.tmpl"
+if(content.logged_in) {
+#line 6 "tests-flags/coalesce-text-define.tmpl"
+out() << "welcome back";
+#line 6 "tests-flags/coalesce-text-define.tmpl"
+}  else  {
+#line 6 "tests-flags/coalesce-text-define.tmpl"
+out() << "please log in";
+#line 6 "tests-flags/coalesce-text-define.tmpl"
+} 
+#line 7 "tests-flags/coalesce-text-define.tmpl"
+out() << "\n";
+#line 7 "tests-flags/coalesce-text-define.tmpl"
+if(!(content.logged_in)) {
+#line 7 "tests-flags/coalesce-text-define.tmpl"
+out() << "<a href=\"/login\">log in</a>";
+#line 7 "tests-flags/coalesce-text-define.tmpl"
+}  // endif
+#line 9 "tests-flags/coalesce-text-define.tmpl"
+out() << "\n<p>footer</p>\n";
+#line 9 "tests-flags/coalesce-text-define.tmpl"
+} // end of template render
+#line 10 "tests-flags/coalesce-text-define.tmpl"
+}; // end of class page
+#line 11 "tests-flags/coalesce-text-define.tmpl"
+} // end of namespace coalesce_text_define
+
+#line 12 "tests-flags/coalesce-text-define.tmpl"
+namespace {
+#line 12 "tests-flags/coalesce-text-define.tmpl"
+cppcms::views::generator my_generator;
+#line 12 "tests-flags/coalesce-text-define.tmpl"
+struct loader {
+#line 12 "tests-flags/coalesce-text-define.tmpl"
+loader() {
+#line 12 "tests-flags/coalesce-text-define.tmpl"
+my_generator.name("coalesce_text_define");
+#line 12 "tests-flags/coalesce-text-define.tmpl"
+my_generator.add_view< coalesce_text_define::page, bench_data::page >("page", true);
+#line 12 "tests-flags/coalesce-text-define.tmpl"
+cppcms::views::pool::instance().add(my_generator);
+#line 12 "tests-flags/coalesce-text-define.tmpl"
+}
+#line 12 "tests-flags/coalesce-text-define.tmpl"
+~loader() { cppcms::views::pool::instance().remove(my_generator); }
+#line 12 "tests-flags/coalesce-text-define.tmpl"
+} a_loader;
+#line 12 "tests-flags/coalesce-text-define.tmpl"
+} // anon 
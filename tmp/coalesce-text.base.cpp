@@ -0,0 +1,69 @@
+#line 1 "tests-flags/coalesce-text.tmpl"
+#include "bench_data.h" 
+#line 2 "tests-flags/coalesce-text.tmpl"
+namespace coalesce_text {
+#line 3 "tests-flags/coalesce-text.tmpl"
+struct page:public cppcms::base_view
+#line 3 "tests-flags/coalesce-text.tmpl"
+ {
+#line 3 "tests-flags/coalesce-text.tmpl"
+bench_data::page & content;
+#line 3 "tests-flags/coalesce-text.tmpl"
+page(std::ostream & _s, bench_data::page & _content):cppcms::base_view(_s),content(_content)
+#line 3 "tests-flags/coalesce-text.tmpl"
+{
+#line 3 "tests-flags/coalesce-text.tmpl"
+}
+#line 4 "tests-flags/coalesce-text.tmpl"
+virtual void render(){
+#line 5 "tests-flags/coalesce-text.tmpl"
+out() << "\n<h1>";
+#line 5 "tests-flags/coalesce-text.tmpl"
+out() << cppcms::filters::escape(content.title);
+#line 6 "tests-flags/coalesce-text.tmpl"
+out() << "</h1>\n";
+#line 6 "tests-flags/coalesce-text.tmpl"
+if(content.logged_in) {
+#line 6 "tests-flags/coalesce-text.tmpl"
+out() << "Hello ";
+#line 6 "tests-flags/coalesce-text.tmpl"
+out() << cppcms::filters::escape(content.user.name);
+#line 7 "tests-flags/coalesce-text.tmpl"
+out() << ",\n\twelcome back";
+#line 7 "tests-flags/coalesce-text.tmpl"
+}  else  {
+#line 7 "tests-flags/coalesce-text.tmpl"
+out() << "Please log in";
+#line 7 "tests-flags/coalesce-text.tmpl"
+} 
+#line 9 "tests-flags/coalesce-text.tmpl"
+out() << "\ntext with \"quotes\", a \\ backslash and\ta tab\n";
+#line 9 "tests-flags/coalesce-text.tmpl"
+} // end of template render
+#line 10 "tests-flags/coalesce-text.tmpl"
+}; // end of class page
+#line 11 "tests-flags/coalesce-text.tmpl"
+} // end of namespace coalesce_text
+
+#line 12 "tests-flags/coalesce-text.tmpl"
+namespace {
+#line 12 "tests-flags/coalesce-text.tmpl"
+cppcms::views::generator my_generator;
+#line 12 "tests-flags/coalesce-text.tmpl"
+struct loader {
+#line 12 "tests-flags/coalesce-text.tmpl"
+loader() {
+#line 12 "tests-flags/coalesce-text.tmpl"
+my_generator.name("coalesce_text");
+#line 12 "tests-flags/coalesce-text.tmpl"
+my_generator.add_view< coalesce_text::page, bench_data::page >("page", true);
+#line 12 "tests-flags/coalesce-text.tmpl"
+cppcms::views::pool::instance().add(my_generator);
+#line 12 "tests-flags/coalesce-text.tmpl"
+}
+#line 12 "tests-flags/coalesce-text.tmpl"
+~loader() { cppcms::views::pool::instance().remove(my_generator); }
+#line 12 "tests-flags/coalesce-text.tmpl"
+} a_loader;
+#line 12 "tests-flags/coalesce-text.tmpl"
+} // anon 
@@ -0,0 +1,96 @@
+#include <boost/format.hpp>
+#line 1 "tests-flags/compile-format.tmpl"
+#include "bench_data.h" 
+#line 2 "tests-flags/compile-format.tmpl"
+namespace compile_format {
+#line 3 "tests-flags/compile-format.tmpl"
+struct page:public cppcms::base_view
+#line 3 "tests-flags/compile-format.tmpl"
+ {
+#line 3 "tests-flags/compile-format.tmpl"
+bench_data::page & content;
+#line 3 "tests-flags/compile-format.tmpl"
+page(std::ostream & _s, bench_data::page & _content):cppcms::base_view(_s),content(_content)
+#line 3 "tests-flags/compile-format.tmpl"
+{
+#line 3 "tests-flags/compile-format.tmpl"
+}
+#line 4 "tests-flags/compile-format.tmpl"
+virtual void show(double price, int n, std::string s){
+#line 5 "tests-flags/compile-format.tmpl"
+out() << "\npositional: ";
+#line 5 "tests-flags/compile-format.tmpl"
+out() << cppcms::filters::escape((boost::format("%1% and %2%, %1% again")% (s)% (n)).str());
+#line 6 "tests-flags/compile-format.tmpl"
+out() << "\nnumbered: ";
+#line 6 "tests-flags/compile-format.tmpl"
+out() << cppcms::filters::escape((boost::format("%2$s before %1$d")% (n)% (s)).str());
+#line 7 "tests-flags/compile-format.tmpl"
+out() << "\nflags: ";
+#line 7 "tests-flags/compile-format.tmpl"
+out() << cppcms::filters::escape((boost::format("[%-5d] [%05d] [%+d] [%x] [%#x] [%#o] [%X]")% (n)% (n)% (n)% (n)% (n)% (n)% (n)).str());
+#line 8 "tests-flags/compile-format.tmpl"
+out() << "\nprecision: ";
+#line 8 "tests-flags/compile-format.tmpl"
+out() << cppcms::filters::escape((boost::format("[%.2f] [%10.3e] [%-10.3f] [%g] [%G] [%E] [%+.1f] [%#g]")% (price)% (price)% (price)% (price)% (price)% (price)% (price)% (price)).str());
+#line 9 "tests-flags/compile-format.tmpl"
+out() << "\nstrings: ";
+#line 9 "tests-flags/compile-format.tmpl"
+out() << cppcms::filters::escape((boost::format("[%s] [%10s] [%-10s] 100%%")% (s)% (s)% (s)).str());
+#line 10 "tests-flags/compile-format.tmpl"
+out() << "\nescaped: ";
+#line 10 "tests-flags/compile-format.tmpl"
+out() << cppcms::filters::escape((boost::format("<b>%1%</b> & co")% (s)).str());
+#line 10 "tests-flags/compile-format.tmpl"
+out() << " raw: ";
+#line 10 "tests-flags/compile-format.tmpl"
+out() << (boost::format("<b>%1%</b> & co")% (s)).str();
+#line 11 "tests-flags/compile-format.tmpl"
+out() << "\nfallback: ";
+#line 11 "tests-flags/compile-format.tmpl"
+out() << cppcms::filters::escape((boost::format("[%|5|] [%c] [%.3s]")% (n)% (n)% (s)).str());
+#line 12 "tests-flags/compile-format.tmpl"
+out() << "\n";
+#line 12 "tests-flags/compile-format.tmpl"
+} // end of template show
+#line 13 "tests-flags/compile-format.tmpl"
+virtual void render(){
+#line 14 "tests-flags/compile-format.tmpl"
+out() << "\n";
+#line 14 "tests-flags/compile-format.tmpl"
+show(  1234.5678, 42, "a <b> & c");
+#line 15 "tests-flags/compile-format.tmpl"
+out() << "\n";
+#line 15 "tests-flags/compile-format.tmpl"
+show(  -0.5, -7, "");
+#line 16 "tests-flags/compile-format.tmpl"
+out() << "\n";
+#line 16 "tests-flags/compile-format.tmpl"
+} // end of template render
+#line 17 "tests-flags/compile-format.tmpl"
+}; // end of class page
+#line 18 "tests-flags/compile-format.tmpl"
+} // end of namespace compile_format
+
+#line 19 "tests-flags/compile-format.tmpl"
+namespace {
+#line 19 "tests-flags/compile-format.tmpl"
+cppcms::views::generator my_generator;
+#line 19 "tests-flags/compile-format.tmpl"
+struct loader {
+#line 19 "tests-flags/compile-format.tmpl"
+loader() {
+#line 19 "tests-flags/compile-format.tmpl"
+my_generator.name("compile_format");
+#line 19 "tests-flags/compile-format.tmpl"
+my_generator.add_view< compile_format::page, bench_data::page >("page", true);
+#line 19 "tests-flags/compile-format.tmpl"
+cppcms::views::pool::instance().add(my_generator);
+#line 19 "tests-flags/compile-format.tmpl"
+}
+#line 19 "tests-flags/compile-format.tmpl"
+~loader() { cppcms::views::pool::instance().remove(my_generator); }
+#line 19 "tests-flags/compile-format.tmpl"
+} a_loader;
+#line 19 "tests-flags/compile-format.tmpl"
+} // anon 
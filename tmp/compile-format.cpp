@@ -0,0 +1,97 @@
+#include <boost/format.hpp>
+#include <cppcms_tmpl/format.h>
+#line 1 "tests-flags/compile-format.tmpl"
+#include "bench_data.h" 
+#line 2 "tests-flags/compile-format.tmpl"
+namespace compile_format {
+#line 3 "tests-flags/compile-format.tmpl"
+struct page:public cppcms::base_view
+#line 3 "tests-flags/compile-format.tmpl"
+ {
+#line 3 "tests-flags/compile-format.tmpl"
+bench_data::page & content;
+#line 3 "tests-flags/compile-format.tmpl"
+page(std::ostream & _s, bench_data::page & _content):cppcms::base_view(_s),content(_content)
+#line 3 "tests-flags/compile-format.tmpl"
+{
+#line 3 "tests-flags/compile-format.tmpl"
+}
+#line 4 "tests-flags/compile-format.tmpl"
+virtual void show(double price, int n, std::string s){
+#line 5 "tests-flags/compile-format.tmpl"
+out() << "\npositional: ";
+#line 5 "tests-flags/compile-format.tmpl"
+{ auto const &_cppcms_fmt_1 = (s); cppcms_tmpl::format_arg(out(), _cppcms_fmt_1, true, std::ios_base::skipws | std::ios_base::dec); out().write(" and ", 5); cppcms_tmpl::format_arg(out(), n, true, std::ios_base::skipws | std::ios_base::dec); out().write(", ", 2); cppcms_tmpl::format_arg(out(), _cppcms_fmt_1, true, std::ios_base::skipws | std::ios_base::dec); out().write(" again", 6); }
+#line 6 "tests-flags/compile-format.tmpl"
+out() << "\nnumbered: ";
+#line 6 "tests-flags/compile-format.tmpl"
+cppcms_tmpl::format_arg(out(), s, true, std::ios_base::skipws | std::ios_base::dec); out().write(" before ", 8); cppcms_tmpl::format_arg(out(), n, true, std::ios_base::skipws | std::ios_base::dec);
+#line 7 "tests-flags/compile-format.tmpl"
+out() << "\nflags: ";
+#line 7 "tests-flags/compile-format.tmpl"
+out().write("[", 1); cppcms_tmpl::format_arg(out(), n, true, std::ios_base::skipws | std::ios_base::dec | std::ios_base::left, 5, 6); out().write("] [", 3); cppcms_tmpl::format_arg(out(), n, true, std::ios_base::skipws | std::ios_base::dec | std::ios_base::internal, 5, 6, '0'); out().write("] [", 3); cppcms_tmpl::format_arg(out(), n, true, std::ios_base::skipws | std::ios_base::dec | std::ios_base::showpos); out().write("] [", 3); cppcms_tmpl::format_arg(out(), n, true, std::ios_base::skipws | std::ios_base::hex); out().write("] [", 3); cppcms_tmpl::format_arg(out(), n, true, std::ios_base::skipws | std::ios_base::hex | std::ios_base::showbase | std::ios_base::showpoint); out().write("] [", 3); cppcms_tmpl::format_arg(out(), n, true, std::ios_base::skipws | std::ios_base::oct | std::ios_base::showbase | std::ios_base::showpoint); out().write("] [", 3); cppcms_tmpl::format_arg(out(), n, true, std::ios_base::skipws | std::ios_base::hex | std::ios_base::uppercase); out().write("]", 1);
+#line 8 "tests-flags/compile-format.tmpl"
+out() << "\nprecision: ";
+#line 8 "tests-flags/compile-format.tmpl"
+out().write("[", 1); cppcms_tmpl::format_arg(out(), price, true, std::ios_base::skipws | std::ios_base::dec | std::ios_base::fixed, 0, 2); out().write("] [", 3); cppcms_tmpl::format_arg(out(), price, true, std::ios_base::skipws | std::ios_base::dec | std::ios_base::scientific, 10, 3); out().write("] [", 3); cppcms_tmpl::format_arg(out(), price, true, std::ios_base::skipws | std::ios_base::dec | std::ios_base::fixed | std::ios_base::left, 10, 3); out().write("] [", 3); cppcms_tmpl::format_arg(out(), price, true, std::ios_base::skipws | std::ios_base::dec); out().write("] [", 3); cppcms_tmpl::format_arg(out(), price, true, std::ios_base::skipws | std::ios_base::dec | std::ios_base::uppercase); out().write("] [", 3); cppcms_tmpl::format_arg(out(), price, true, std::ios_base::skipws | std::ios_base::dec | std::ios_base::scientific | std::ios_base::uppercase); out().write("] [", 3); cppcms_tmpl::format_arg(out(), price, true, std::ios_base::skipws | std::ios_base::dec | std::ios_base::fixed | std::ios_base::showpos, 0, 1); out().write("] [", 3); cppcms_tmpl::format_arg(out(), price, true, std::ios_base::skipws | std::ios_base::dec | std::ios_base::showbase | std::ios_base::showpoint); out().write("]", 1);
+#line 9 "tests-flags/compile-format.tmpl"
+out() << "\nstrings: ";
+#line 9 "tests-flags/compile-format.tmpl"
+out().write("[", 1); cppcms_tmpl::format_arg(out(), s, true, std::ios_base::skipws | std::ios_base::dec); out().write("] [", 3); cppcms_tmpl::format_arg(out(), s, true, std::ios_base::skipws | std::ios_base::dec, 10, 6); out().write("] [", 3); cppcms_tmpl::format_arg(out(), s, true, std::ios_base::skipws | std::ios_base::dec | std::ios_base::left, 10, 6); out().write("] 100%", 6);
+#line 10 "tests-flags/compile-format.tmpl"
+out() << "\nescaped: ";
+#line 10 "tests-flags/compile-format.tmpl"
+out().write("&lt;b&gt;", 9); cppcms_tmpl::format_arg(out(), s, true, std::ios_base::skipws | std::ios_base::dec); out().write("&lt;/b&gt; &amp; co", 19);
+#line 10 "tests-flags/compile-format.tmpl"
+out() << " raw: ";
+#line 10 "tests-flags/compile-format.tmpl"
+out().write("<b>", 3); cppcms_tmpl::format_arg(out(), s, false, std::ios_base::skipws | std::ios_base::dec); out().write("</b> & co", 9);
+#line 11 "tests-flags/compile-format.tmpl"
+out() << "\nfallback: ";
+#line 11 "tests-flags/compile-format.tmpl"
+out() << cppcms::filters::escape((boost::format("[%|5|] [%c] [%.3s]")% (n)% (n)% (s)).str());
+#line 12 "tests-flags/compile-format.tmpl"
+out() << "\n";
+#line 12 "tests-flags/compile-format.tmpl"
+} // end of template show
+#line 13 "tests-flags/compile-format.tmpl"
+virtual void render(){
+#line 14 "tests-flags/compile-format.tmpl"
+out() << "\n";
+#line 14 "tests-flags/compile-format.tmpl"
+show(  1234.5678, 42, "a <b> & c");
+#line 15 "tests-flags/compile-format.tmpl"
+out() << "\n";
+#line 15 "tests-flags/compile-format.tmpl"
+show(  -0.5, -7, "");
+#line 16 "tests-flags/compile-format.tmpl"
+out() << "\n";
+#line 16 "tests-flags/compile-format.tmpl"
+} // end of template render
+#line 17 "tests-flags/compile-format.tmpl"
+}; // end of class page
+#line 18 "tests-flags/compile-format.tmpl"
+} // end of namespace compile_format
+
+#line 19 "tests-flags/compile-format.tmpl"
+namespace {
+#line 19 "tests-flags/compile-format.tmpl"
+cppcms::views::generator my_generator;
+#line 19 "tests-flags/compile-format.tmpl"
+struct loader {
+#line 19 "tests-flags/compile-format.tmpl"
+loader() {
+#line 19 "tests-flags/compile-format.tmpl"
+my_generator.name("compile_format");
+#line 19 "tests-flags/compile-format.tmpl"
+my_generator.add_view< compile_format::page, bench_data::page >("page", true);
+#line 19 "tests-flags/compile-format.tmpl"
+cppcms::views::pool::instance().add(my_generator);
+#line 19 "tests-flags/compile-format.tmpl"
+}
+#line 19 "tests-flags/compile-format.tmpl"
+~loader() { cppcms::views::pool::instance().remove(my_generator); }
+#line 19 "tests-flags/compile-format.tmpl"
+} a_loader;
+#line 19 "tests-flags/compile-format.tmpl"
+} // anon 
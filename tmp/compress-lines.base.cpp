@@ -0,0 +1,67 @@
+#line 1 "tests-flags/compress-lines.tmpl"
+#include "bench_data.h" 
+#line 2 "tests-flags/compress-lines.tmpl"
+namespace compress_lines {
+#line 3 "tests-flags/compress-lines.tmpl"
+struct page:public cppcms::base_view
+#line 3 "tests-flags/compress-lines.tmpl"
+ {
+#line 3 "tests-flags/compress-lines.tmpl"
+bench_data::page & content;
+#line 3 "tests-flags/compress-lines.tmpl"
+page(std::ostream & _s, bench_data::page & _content):cppcms::base_view(_s),content(_content)
+#line 3 "tests-flags/compress-lines.tmpl"
+{
+#line 3 "tests-flags/compress-lines.tmpl"
+}
+#line 4 "tests-flags/compress-lines.tmpl"
+virtual void render(){
+#line 5 "tests-flags/compress-lines.tmpl"
+out() << "\n<h1>";
+#line 5 "tests-flags/compress-lines.tmpl"
+out() << cppcms::filters::escape(content.title);
+#line 6 "tests-flags/compress-lines.tmpl"
+out() << "</h1>\n";
+#line 6 "tests-flags/compress-lines.tmpl"
+if(content.logged_in) {
+#line 6 "tests-flags/compress-lines.tmpl"
+out() << "Hello ";
+#line 6 "tests-flags/compress-lines.tmpl"
+out() << cppcms::filters::escape(content.user.name);
+#line 6 "tests-flags/compress-lines.tmpl"
+}  // endif
+#line 10 "tests-flags/compress-lines.tmpl"
+out() << "\n\n\n\n<p>far below</p>";
+#line 10 "tests-flags/compress-lines.tmpl"
+out() << content.count; 
+#line 11 "tests-flags/compress-lines.tmpl"
+out() << "\n";
+#line 11 "tests-flags/compress-lines.tmpl"
+} // end of template render
+#line 12 "tests-flags/compress-lines.tmpl"
+}; // end of class page
+#line 13 "tests-flags/compress-lines.tmpl"
+} // end of namespace compress_lines
+
+#line 14 "tests-flags/compress-lines.tmpl"
+namespace {
+#line 14 "tests-flags/compress-lines.tmpl"
+cppcms::views::generator my_generator;
+#line 14 "tests-flags/compress-lines.tmpl"
+struct loader {
+#line 14 "tests-flags/compress-lines.tmpl"
+loader() {
+#line 14 "tests-flags/compress-lines.tmpl"
+my_generator.name("compress_lines");
+#line 14 "tests-flags/compress-lines.tmpl"
+my_generator.add_view< compress_lines::page, bench_data::page >("page", true);
+#line 14 "tests-flags/compress-lines.tmpl"
+cppcms::views::pool::instance().add(my_generator);
+#line 14 "tests-flags/compress-lines.tmpl"
+}
+#line 14 "tests-flags/compress-lines.tmpl"
+~loader() { cppcms::views::pool::instance().remove(my_generator); }
+#line 14 "tests-flags/compress-lines.tmpl"
+} a_loader;
+#line 14 "tests-flags/compress-lines.tmpl"
+} // anon 
@@ -0,0 +1,73 @@
+#line 1 "tests-flags/define.tmpl"
+#include "bench_data.h" 
+#line 2 "tests-flags/define.tmpl"
+namespace define {
+#line 3 "tests-flags/define.tmpl"
+struct page:public cppcms::base_view
+#line 3 "tests-flags/define.tmpl"
+ {
+#line 3 "tests-flags/define.tmpl"
+bench_data::page & content;
+#line 3 "tests-flags/define.tmpl"
+page(std::ostream & _s, bench_data::page & _content):cppcms::base_view(_s),content(_content)
+#line 3 "tests-flags/define.tmpl"
+{
+#line 3 "tests-flags/define.tmpl"
+}
+#line 4 "tests-flags/define.tmpl"
+virtual void render(){
+#line 5 "tests-flags/define.tmpl"
+out() << "\n";
+ {
+#line 5 "tests-flags/define.tmpl"
+out() << "Please log in";
+#line 5 "tests-flags/define.tmpl"
+} 
+#line 6 "tests-flags/define.tmpl"
+out() << "\n";
+ {
+#line 6 "tests-flags/define.tmpl"
+out() << "<a href=\"/login\">log in</a>";
+#line 6 "tests-flags/define.tmpl"
+} 
+#line 7 "tests-flags/define.tmpl"
+out() << "\n";
+#line 7 "tests-flags/define.tmpl"
+if(content.count) {
+#line 7 "tests-flags/define.tmpl"
+out() << cppcms::filters::escape(content.count);
+#line 7 "tests-flags/define.tmpl"
+out() << " items";
+#line 7 "tests-flags/define.tmpl"
+}  // endif
+#line 8 "tests-flags/define.tmpl"
+out() << "\n";
+#line 8 "tests-flags/define.tmpl"
+} // end of template render
+#line 9 "tests-flags/define.tmpl"
+}; // end of class page
+#line 10 "tests-flags/define.tmpl"
+} // end of namespace define
+
+#line 11 "tests-flags/define.tmpl"
+namespace {
+#line 11 "tests-flags/define.tmpl"
+cppcms::views::generator my_generator;
+#line 11 "tests-flags/define.tmpl"
+struct loader {
+#line 11 "tests-flags/define.tmpl"
+loader() {
+#line 11 "tests-flags/define.tmpl"
+my_generator.name("define");
+#line 11 "tests-flags/define.tmpl"
+my_generator.add_view< define::page, bench_data::page >("page", true);
+#line 11 "tests-flags/define.tmpl"
+cppcms::views::pool::instance().add(my_generator);
+#line 11 "tests-flags/define.tmpl"
+}
+#line 11 "tests-flags/define.tmpl"
+~loader() { cppcms::views::pool::instance().remove(my_generator); }
+#line 11 "tests-flags/define.tmpl"
+} a_loader;
+#line 11 "tests-flags/define.tmpl"
+} // anon 
@@ -0,0 +1,103 @@
+#line 1 "tests-flags/fast-cache.tmpl"
+#include "bench_data.h" 
+#line 2 "tests-flags/fast-cache.tmpl"
+namespace fast_cache {
+#line 3 "tests-flags/fast-cache.tmpl"
+struct page:public cppcms::base_view
+#line 3 "tests-flags/fast-cache.tmpl"
+ {
+#line 3 "tests-flags/fast-cache.tmpl"
+bench_data::page & content;
+#line 3 "tests-flags/fast-cache.tmpl"
+page(std::ostream & _s, bench_data::page & _content):cppcms::base_view(_s),content(_content)
+#line 3 "tests-flags/fast-cache.tmpl"
+{
+#line 3 "tests-flags/fast-cache.tmpl"
+}
+#line 4 "tests-flags/fast-cache.tmpl"
+virtual void render(){
+#line 5 "tests-flags/fast-cache.tmpl"
+out() << "\n";
+#line 5 "tests-flags/fast-cache.tmpl"
+{
+std::string _cppcms_temp_val;
+#line 5 "tests-flags/fast-cache.tmpl"
+	if (content.app().cache().fetch_frame("side", _cppcms_temp_val))
+#line 5 "tests-flags/fast-cache.tmpl"
+		out() << _cppcms_temp_val;
+#line 5 "tests-flags/fast-cache.tmpl"
+	else {
+#line 5 "tests-flags/fast-cache.tmpl"
+		cppcms::copy_filter _cppcms_cache_flt(out());
+#line 5 "tests-flags/fast-cache.tmpl"
+		cppcms::triggers_recorder _cppcms_trig_rec(content.app().cache());
+#line 5 "tests-flags/fast-cache.tmpl"
+out() << "<div>";
+#line 5 "tests-flags/fast-cache.tmpl"
+out() << cppcms::filters::escape(content.title);
+#line 5 "tests-flags/fast-cache.tmpl"
+out() << " ";
+#line 5 "tests-flags/fast-cache.tmpl"
+out() << cppcms::filters::escape(content.count);
+#line 5 "tests-flags/fast-cache.tmpl"
+out() << "</div>";
+#line 5 "tests-flags/fast-cache.tmpl"
+content.app().cache().store_frame("side", _cppcms_cache_flt.detach(),_cppcms_trig_rec.detach(),-1, false);
+#line 5 "tests-flags/fast-cache.tmpl"
+	}} // cache
+#line 6 "tests-flags/fast-cache.tmpl"
+out() << "\n";
+#line 6 "tests-flags/fast-cache.tmpl"
+{
+std::string _cppcms_temp_val;
+#line 6 "tests-flags/fast-cache.tmpl"
+	if (content.app().cache().fetch_frame("other", _cppcms_temp_val))
+#line 6 "tests-flags/fast-cache.tmpl"
+		out() << _cppcms_temp_val;
+#line 6 "tests-flags/fast-cache.tmpl"
+	else {
+#line 6 "tests-flags/fast-cache.tmpl"
+		cppcms::copy_filter _cppcms_cache_flt(out());
+#line 6 "tests-flags/fast-cache.tmpl"
+		cppcms::triggers_recorder _cppcms_trig_rec(content.app().cache());
+#line 6 "tests-flags/fast-cache.tmpl"
+out() << "<div>";
+#line 6 "tests-flags/fast-cache.tmpl"
+out() << cppcms::filters::escape(content.count);
+#line 6 "tests-flags/fast-cache.tmpl"
+out() << "</div>";
+#line 6 "tests-flags/fast-cache.tmpl"
+content.app().cache().store_frame("other", _cppcms_cache_flt.detach(),_cppcms_trig_rec.detach(),60, true);
+#line 6 "tests-flags/fast-cache.tmpl"
+	}} // cache
+#line 7 "tests-flags/fast-cache.tmpl"
+out() << "\n";
+#line 7 "tests-flags/fast-cache.tmpl"
+} // end of template render
+#line 8 "tests-flags/fast-cache.tmpl"
+}; // end of class page
+#line 9 "tests-flags/fast-cache.tmpl"
+} // end of namespace fast_cache
+
+#line 10 "tests-flags/fast-cache.tmpl"
+namespace {
+#line 10 "tests-flags/fast-cache.tmpl"
+cppcms::views::generator my_generator;
+#line 10 "tests-flags/fast-cache.tmpl"
+struct loader {
+#line 10 "tests-flags/fast-cache.tmpl"
+loader() {
+#line 10 "tests-flags/fast-cache.tmpl"
+my_generator.name("fast_cache");
+#line 10 "tests-flags/fast-cache.tmpl"
+my_generator.add_view< fast_cache::page, bench_data::page >("page", true);
+#line 10 "tests-flags/fast-cache.tmpl"
+cppcms::views::pool::instance().add(my_generator);
+#line 10 "tests-flags/fast-cache.tmpl"
+}
+#line 10 "tests-flags/fast-cache.tmpl"
+~loader() { cppcms::views::pool::instance().remove(my_generator); }
+#line 10 "tests-flags/fast-cache.tmpl"
+} a_loader;
+#line 10 "tests-flags/fast-cache.tmpl"
+} // anon 
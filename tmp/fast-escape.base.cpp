@@ -0,0 +1,85 @@
+#line 1 "tests-flags/fast-escape.tmpl"
+#include "bench_data.h" 
+#line 2 "tests-flags/fast-escape.tmpl"
+namespace fast_escape {
+#line 3 "tests-flags/fast-escape.tmpl"
+struct page:public cppcms::base_view
+#line 3 "tests-flags/fast-escape.tmpl"
+ {
+#line 3 "tests-flags/fast-escape.tmpl"
+bench_data::page & content;
+#line 3 "tests-flags/fast-escape.tmpl"
+page(std::ostream & _s, bench_data::page & _content):cppcms::base_view(_s),content(_content)
+#line 3 "tests-flags/fast-escape.tmpl"
+{
+#line 3 "tests-flags/fast-escape.tmpl"
+}
+#line 4 "tests-flags/fast-escape.tmpl"
+virtual void render(){
+#line 5 "tests-flags/fast-escape.tmpl"
+out() << "\n<h1>";
+#line 5 "tests-flags/fast-escape.tmpl"
+out() << cppcms::filters::escape(content.title);
+#line 5 "tests-flags/fast-escape.tmpl"
+out() << "</h1> ";
+#line 5 "tests-flags/fast-escape.tmpl"
+out() << cppcms::filters::escape(content.count);
+#line 5 "tests-flags/fast-escape.tmpl"
+out() << " ";
+#line 5 "tests-flags/fast-escape.tmpl"
+out() << cppcms::filters::escape(content.user.name);
+#line 5 "tests-flags/fast-escape.tmpl"
+out() << " ";
+#line 5 "tests-flags/fast-escape.tmpl"
+out() << cppcms::filters::downcase(  content.user.name);
+#line 5 "tests-flags/fast-escape.tmpl"
+out() << " ";
+#line 5 "tests-flags/fast-escape.tmpl"
+out() << cppcms::filters::raw(  content.title);
+#line 5 "tests-flags/fast-escape.tmpl"
+out() << " ";
+#line 5 "tests-flags/fast-escape.tmpl"
+if((content.items).begin() != (content.items).end()) {
+#line 5 "tests-flags/fast-escape.tmpl"
+for (CPPCMS_TYPEOF((content.items).begin()) it_ptr = (content.items).begin(), it_ptr_end = (content.items).end(); it_ptr != it_ptr_end; ++it_ptr) {
+#line 5 "tests-flags/fast-escape.tmpl"
+CPPCMS_TYPEOF(*it_ptr) & it = *it_ptr;
+#line 5 "tests-flags/fast-escape.tmpl"
+out() << cppcms::filters::escape(it.summary);
+#line 5 "tests-flags/fast-escape.tmpl"
+out() << "|";
+#line 5 "tests-flags/fast-escape.tmpl"
+} // end of item
+#line 5 "tests-flags/fast-escape.tmpl"
+}
+#line 6 "tests-flags/fast-escape.tmpl"
+out() << "\n";
+#line 6 "tests-flags/fast-escape.tmpl"
+} // end of template render
+#line 7 "tests-flags/fast-escape.tmpl"
+}; // end of class page
+#line 8 "tests-flags/fast-escape.tmpl"
+} // end of namespace fast_escape
+
+#line 9 "tests-flags/fast-escape.tmpl"
+namespace {
+#line 9 "tests-flags/fast-escape.tmpl"
+cppcms::views::generator my_generator;
+#line 9 "tests-flags/fast-escape.tmpl"
+struct loader {
+#line 9 "tests-flags/fast-escape.tmpl"
+loader() {
+#line 9 "tests-flags/fast-escape.tmpl"
+my_generator.name("fast_escape");
+#line 9 "tests-flags/fast-escape.tmpl"
+my_generator.add_view< fast_escape::page, bench_data::page >("page", true);
+#line 9 "tests-flags/fast-escape.tmpl"
+cppcms::views::pool::instance().add(my_generator);
+#line 9 "tests-flags/fast-escape.tmpl"
+}
+#line 9 "tests-flags/fast-escape.tmpl"
+~loader() { cppcms::views::pool::instance().remove(my_generator); }
+#line 9 "tests-flags/fast-escape.tmpl"
+} a_loader;
+#line 9 "tests-flags/fast-escape.tmpl"
+} // anon 
@@ -0,0 +1,67 @@
+#line 1 "tests-flags/hoist-out.tmpl"
+#include "bench_data.h" 
+#line 2 "tests-flags/hoist-out.tmpl"
+namespace hoist_out {
+#line 3 "tests-flags/hoist-out.tmpl"
+struct page:public cppcms::base_view
+#line 3 "tests-flags/hoist-out.tmpl"
+ {
+#line 3 "tests-flags/hoist-out.tmpl"
+bench_data::page & content;
+#line 3 "tests-flags/hoist-out.tmpl"
+page(std::ostream & _s, bench_data::page & _content):cppcms::base_view(_s),content(_content)
+#line 3 "tests-flags/hoist-out.tmpl"
+{
+#line 3 "tests-flags/hoist-out.tmpl"
+}
+#line 4 "tests-flags/hoist-out.tmpl"
+virtual void nothing(){
+#line 4 "tests-flags/hoist-out.tmpl"
+} // end of template nothing
+#line 5 "tests-flags/hoist-out.tmpl"
+virtual void render(){
+#line 5 "tests-flags/hoist-out.tmpl"
+std::ostream &_cppcms_out = out();
+#line 6 "tests-flags/hoist-out.tmpl"
+_cppcms_out << "\n<h1>";
+#line 6 "tests-flags/hoist-out.tmpl"
+_cppcms_out << cppcms::filters::escape(content.title);
+#line 6 "tests-flags/hoist-out.tmpl"
+_cppcms_out << "</h1>";
+#line 6 "tests-flags/hoist-out.tmpl"
+nothing(  );
+#line 7 "tests-flags/hoist-out.tmpl"
+_cppcms_out << "\n";
+#line 7 "tests-flags/hoist-out.tmpl"
+out() << "<!-- c++ -->"; 
+#line 8 "tests-flags/hoist-out.tmpl"
+_cppcms_out << "\n";
+#line 8 "tests-flags/hoist-out.tmpl"
+} // end of template render
+#line 9 "tests-flags/hoist-out.tmpl"
+}; // end of class page
+#line 10 "tests-flags/hoist-out.tmpl"
+} // end of namespace hoist_out
+
+#line 11 "tests-flags/hoist-out.tmpl"
+namespace {
+#line 11 "tests-flags/hoist-out.tmpl"
+cppcms::views::generator my_generator;
+#line 11 "tests-flags/hoist-out.tmpl"
+struct loader {
+#line 11 "tests-flags/hoist-out.tmpl"
+loader() {
+#line 11 "tests-flags/hoist-out.tmpl"
+my_generator.name("hoist_out");
+#line 11 "tests-flags/hoist-out.tmpl"
+my_generator.add_view< hoist_out::page, bench_data::page >("page", true);
+#line 11 "tests-flags/hoist-out.tmpl"
+cppcms::views::pool::instance().add(my_generator);
+#line 11 "tests-flags/hoist-out.tmpl"
+}
+#line 11 "tests-flags/hoist-out.tmpl"
+~loader() { cppcms::views::pool::instance().remove(my_generator); }
+#line 11 "tests-flags/hoist-out.tmpl"
+} a_loader;
+#line 11 "tests-flags/hoist-out.tmpl"
+} // anon 
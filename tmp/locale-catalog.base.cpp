@@ -0,0 +1,65 @@
+#line 1 "tests-flags/locale-catalog.tmpl"
+#include "bench_data.h" 
+#line 2 "tests-flags/locale-catalog.tmpl"
+namespace locale_catalog {
+#line 3 "tests-flags/locale-catalog.tmpl"
+struct page:public cppcms::base_view
+#line 3 "tests-flags/locale-catalog.tmpl"
+ {
+#line 3 "tests-flags/locale-catalog.tmpl"
+bench_data::page & content;
+#line 3 "tests-flags/locale-catalog.tmpl"
+page(std::ostream & _s, bench_data::page & _content):cppcms::base_view(_s),content(_content)
+#line 3 "tests-flags/locale-catalog.tmpl"
+{
+#line 3 "tests-flags/locale-catalog.tmpl"
+}
+#line 4 "tests-flags/locale-catalog.tmpl"
+virtual void render(){
+#line 5 "tests-flags/locale-catalog.tmpl"
+out() << "\n<p>";
+#line 5 "tests-flags/locale-catalog.tmpl"
+out() << cppcms::locale::translate("hello");
+#line 5 "tests-flags/locale-catalog.tmpl"
+out() << " | ";
+#line 5 "tests-flags/locale-catalog.tmpl"
+out() << cppcms::locale::format(cppcms::locale::translate("one file", "{1} files", content.count))  % (cppcms::filters::escape(content.count));
+#line 5 "tests-flags/locale-catalog.tmpl"
+out() << " | ";
+#line 5 "tests-flags/locale-catalog.tmpl"
+out() << cppcms::locale::format(cppcms::locale::translate("one item", "{1} items", content.count))  % (cppcms::filters::escape(content.count));
+#line 5 "tests-flags/locale-catalog.tmpl"
+out() << " | ";
+#line 5 "tests-flags/locale-catalog.tmpl"
+out() << cppcms::locale::translate("untranslated");
+#line 6 "tests-flags/locale-catalog.tmpl"
+out() << "</p>\n";
+#line 6 "tests-flags/locale-catalog.tmpl"
+} // end of template render
+#line 7 "tests-flags/locale-catalog.tmpl"
+}; // end of class page
+#line 8 "tests-flags/locale-catalog.tmpl"
+} // end of namespace locale_catalog
+
+#line 9 "tests-flags/locale-catalog.tmpl"
+namespace {
+#line 9 "tests-flags/locale-catalog.tmpl"
+cppcms::views::generator my_generator;
+#line 9 "tests-flags/locale-catalog.tmpl"
+struct loader {
+#line 9 "tests-flags/locale-catalog.tmpl"
+loader() {
+#line 9 "tests-flags/locale-catalog.tmpl"
+my_generator.name("locale_catalog");
+#line 9 "tests-flags/locale-catalog.tmpl"
+my_generator.add_view< locale_catalog::page, bench_data::page >("page", true);
+#line 9 "tests-flags/locale-catalog.tmpl"
+cppcms::views::pool::instance().add(my_generator);
+#line 9 "tests-flags/locale-catalog.tmpl"
+}
+#line 9 "tests-flags/locale-catalog.tmpl"
+~loader() { cppcms::views::pool::instance().remove(my_generator); }
+#line 9 "tests-flags/locale-catalog.tmpl"
+} a_loader;
+#line 9 "tests-flags/locale-catalog.tmpl"
+} // anon 
@@ -0,0 +1,66 @@
+#include <cppcms_tmpl/catalog.h>
+#line 1 "tests-flags/locale-catalog.tmpl"
+#include "bench_data.h" 
+#line 2 "tests-flags/locale-catalog.tmpl"
+namespace locale_catalog {
+#line 3 "tests-flags/locale-catalog.tmpl"
+struct page:public cppcms::base_view
+#line 3 "tests-flags/locale-catalog.tmpl"
+ {
+#line 3 "tests-flags/locale-catalog.tmpl"
+bench_data::page & content;
+#line 3 "tests-flags/locale-catalog.tmpl"
+page(std::ostream & _s, bench_data::page & _content):cppcms::base_view(_s),content(_content)
+#line 3 "tests-flags/locale-catalog.tmpl"
+{
+#line 3 "tests-flags/locale-catalog.tmpl"
+}
+#line 4 "tests-flags/locale-catalog.tmpl"
+virtual void render(){
+#line 5 "tests-flags/locale-catalog.tmpl"
+out() << "\n<p>";
+#line 5 "tests-flags/locale-catalog.tmpl"
+{ static const cppcms_tmpl::catalog_text _cppcms_tr[] = { { "Gr\303\274\303\237 \"dich\"", 13 }, { "\320\277\321\200\320\270\320\262\320\265\321\202", 12 } }; const int _cppcms_l = cppcms_tmpl::catalog_language<cppcms::locale::info>(out(), "de\000ru\000"); if(_cppcms_l >= 0) { out().write(_cppcms_tr[_cppcms_l].text, _cppcms_tr[_cppcms_l].length); } else { out() << cppcms::locale::translate("hello"); } }
+#line 5 "tests-flags/locale-catalog.tmpl"
+out() << " | ";
+#line 5 "tests-flags/locale-catalog.tmpl"
+{ auto const &_cppcms_n = (content.count); static const cppcms_tmpl::catalog_text _cppcms_tr[] = { { "eine Datei", 10 }, { "{1} Dateien", 11 }, { "{1} \321\204\320\260\320\271\320\273", 12 }, { "{1} \321\204\320\260\320\271\320\273\320\260", 14 }, { "{1} \321\204\320\260\320\271\320\273\320\276\320\262", 16 } }; const int _cppcms_l = cppcms_tmpl::catalog_language<cppcms::locale::info>(out(), "de\000ru\000"); if(_cppcms_l >= 0) { const unsigned long _cppcms_u = _cppcms_n; unsigned long _cppcms_f = 0; switch(_cppcms_l) { case 0: _cppcms_f = (_cppcms_u != 1); _cppcms_f = 0 + (_cppcms_f < 2 ? _cppcms_f : 0); break; case 1: _cppcms_f = (_cppcms_u%10==1 && _cppcms_u%100!=11 ? 0 : _cppcms_u%10>=2 && _cppcms_u%10<=4 && (_cppcms_u%100<10 || _cppcms_u%100>=20) ? 1 : 2); _cppcms_f = 2 + (_cppcms_f < 3 ? _cppcms_f : 0); break; } out() << cppcms::locale::format(std::string(_cppcms_tr[_cppcms_f].text, _cppcms_tr[_cppcms_f].length)) % (cppcms::filters::escape(content.count)); } else { out() << cppcms::locale::format(cppcms::locale::translate("one file", "{1} files", _cppcms_n)) % (cppcms::filters::escape(content.count)); } }
+#line 5 "tests-flags/locale-catalog.tmpl"
+out() << " | ";
+#line 5 "tests-flags/locale-catalog.tmpl"
+{ auto const &_cppcms_n = (content.count); static const cppcms_tmpl::catalog_text _cppcms_tr[] = { { "ein Artikel", 11 }, { "{1} Artikel", 11 }, { "one item", 8 }, { "{1} items", 9 } }; const int _cppcms_l = cppcms_tmpl::catalog_language<cppcms::locale::info>(out(), "de\000ru\000"); if(_cppcms_l >= 0) { const unsigned long _cppcms_u = _cppcms_n; unsigned long _cppcms_f = 0; switch(_cppcms_l) { case 0: _cppcms_f = (_cppcms_u != 1); _cppcms_f = 0 + (_cppcms_f < 2 ? _cppcms_f : 0); break; case 1: _cppcms_f = _cppcms_u == 1 ? 0 : 1; _cppcms_f = 2 + (_cppcms_f < 2 ? _cppcms_f : 0); break; } out() << cppcms::locale::format(std::string(_cppcms_tr[_cppcms_f].text, _cppcms_tr[_cppcms_f].length)) % (cppcms::filters::escape(content.count)); } else { out() << cppcms::locale::format(cppcms::locale::translate("one item", "{1} items", _cppcms_n)) % (cppcms::filters::escape(content.count)); } }
+#line 5 "tests-flags/locale-catalog.tmpl"
+out() << " | ";
+#line 5 "tests-flags/locale-catalog.tmpl"
+{ static const cppcms_tmpl::catalog_text _cppcms_tr[] = { { "untranslated", 12 }, { "untranslated", 12 } }; const int _cppcms_l = cppcms_tmpl::catalog_language<cppcms::locale::info>(out(), "de\000ru\000"); if(_cppcms_l >= 0) { out().write(_cppcms_tr[_cppcms_l].text, _cppcms_tr[_cppcms_l].length); } else { out() << cppcms::locale::translate("untranslated"); } }
+#line 6 "tests-flags/locale-catalog.tmpl"
+out() << "</p>\n";
+#line 6 "tests-flags/locale-catalog.tmpl"
+} // end of template render
+#line 7 "tests-flags/locale-catalog.tmpl"
+}; // end of class page
+#line 8 "tests-flags/locale-catalog.tmpl"
+} // end of namespace locale_catalog
+
+#line 9 "tests-flags/locale-catalog.tmpl"
+namespace {
+#line 9 "tests-flags/locale-catalog.tmpl"
+cppcms::views::generator my_generator;
+#line 9 "tests-flags/locale-catalog.tmpl"
+struct loader {
+#line 9 "tests-flags/locale-catalog.tmpl"
+loader() {
+#line 9 "tests-flags/locale-catalog.tmpl"
+my_generator.name("locale_catalog");
+#line 9 "tests-flags/locale-catalog.tmpl"
+my_generator.add_view< locale_catalog::page, bench_data::page >("page", true);
+#line 9 "tests-flags/locale-catalog.tmpl"
+cppcms::views::pool::instance().add(my_generator);
+#line 9 "tests-flags/locale-catalog.tmpl"
+}
+#line 9 "tests-flags/locale-catalog.tmpl"
+~loader() { cppcms::views::pool::instance().remove(my_generator); }
+#line 9 "tests-flags/locale-catalog.tmpl"
+} a_loader;
+#line 9 "tests-flags/locale-catalog.tmpl"
+} // anon 
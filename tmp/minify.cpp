@@ -0,0 +1,53 @@
+#line 1 "tests-flags/minify.tmpl"
+#include "bench_data.h" 
+#line 3 "tests-flags/minify.tmpl"
+namespace minify {
+#line 4 "tests-flags/minify.tmpl"
+struct page:public cppcms::base_view
+#line 4 "tests-flags/minify.tmpl"
+ {
+#line 4 "tests-flags/minify.tmpl"
+bench_data::page & content;
+#line 4 "tests-flags/minify.tmpl"
+page(std::ostream & _s, bench_data::page & _content):cppcms::base_view(_s),content(_content)
+#line 4 "tests-flags/minify.tmpl"
+{
+#line 4 "tests-flags/minify.tmpl"
+}
+#line 5 "tests-flags/minify.tmpl"
+virtual void render(){
+#line 10 "tests-flags/minify.tmpl"
+out() << "<!DOCTYPE html><html><head><title>";
+#line 10 "tests-flags/minify.tmpl"
+out() << cppcms::filters::escape(content.title);
+#line 20 "tests-flags/minify.tmpl"
+out() << "</title></head><body><pre>  kept\n\t  as is  </pre><p>some text</p></body></html>";
+#line 20 "tests-flags/minify.tmpl"
+} // end of template render
+#line 21 "tests-flags/minify.tmpl"
+}; // end of class page
+#line 22 "tests-flags/minify.tmpl"
+} // end of namespace minify
+
+#line 23 "tests-flags/minify.tmpl"
+namespace {
+#line 23 "tests-flags/minify.tmpl"
+cppcms::views::generator my_generator;
+#line 23 "tests-flags/minify.tmpl"
+struct loader {
+#line 23 "tests-flags/minify.tmpl"
+loader() {
+#line 23 "tests-flags/minify.tmpl"
+my_generator.name("minify");
+#line 23 "tests-flags/minify.tmpl"
+my_generator.add_view< minify::page, bench_data::page >("page", true);
+#line 23 "tests-flags/minify.tmpl"
+cppcms::views::pool::instance().add(my_generator);
+#line 23 "tests-flags/minify.tmpl"
+}
+#line 23 "tests-flags/minify.tmpl"
+~loader() { cppcms::views::pool::instance().remove(my_generator); }
+#line 23 "tests-flags/minify.tmpl"
+} a_loader;
+#line 23 "tests-flags/minify.tmpl"
+} // anon 
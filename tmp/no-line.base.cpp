@@ -0,0 +1,67 @@
+#line 1 "tests-flags/no-line.tmpl"
+#include "bench_data.h" 
+#line 2 "tests-flags/no-line.tmpl"
+namespace no_line {
+#line 3 "tests-flags/no-line.tmpl"
+struct page:public cppcms::base_view
+#line 3 "tests-flags/no-line.tmpl"
+ {
+#line 3 "tests-flags/no-line.tmpl"
+bench_data::page & content;
+#line 3 "tests-flags/no-line.tmpl"
+page(std::ostream & _s, bench_data::page & _content):cppcms::base_view(_s),content(_content)
+#line 3 "tests-flags/no-line.tmpl"
+{
+#line 3 "tests-flags/no-line.tmpl"
+}
+#line 4 "tests-flags/no-line.tmpl"
+virtual void render(){
+#line 5 "tests-flags/no-line.tmpl"
+out() << "\n<h1>";
+#line 5 "tests-flags/no-line.tmpl"
+out() << cppcms::filters::escape(content.title);
+#line 6 "tests-flags/no-line.tmpl"
+out() << "</h1>\n";
+#line 6 "tests-flags/no-line.tmpl"
+if(content.logged_in) {
+#line 6 "tests-flags/no-line.tmpl"
+out() << "Hello ";
+#line 6 "tests-flags/no-line.tmpl"
+out() << cppcms::filters::escape(content.user.name);
+#line 6 "tests-flags/no-line.tmpl"
+}  // endif
+#line 10 "tests-flags/no-line.tmpl"
+out() << "\n\n\n\n<p>far below</p>";
+#line 10 "tests-flags/no-line.tmpl"
+out() << content.count; 
+#line 11 "tests-flags/no-line.tmpl"
+out() << "\n";
+#line 11 "tests-flags/no-line.tmpl"
+} // end of template render
+#line 12 "tests-flags/no-line.tmpl"
+}; // end of class page
+#line 13 "tests-flags/no-line.tmpl"
+} // end of namespace no_line
+
+#line 14 "tests-flags/no-line.tmpl"
+namespace {
+#line 14 "tests-flags/no-line.tmpl"
+cppcms::views::generator my_generator;
+#line 14 "tests-flags/no-line.tmpl"
+struct loader {
+#line 14 "tests-flags/no-line.tmpl"
+loader() {
+#line 14 "tests-flags/no-line.tmpl"
+my_generator.name("no_line");
+#line 14 "tests-flags/no-line.tmpl"
+my_generator.add_view< no_line::page, bench_data::page >("page", true);
+#line 14 "tests-flags/no-line.tmpl"
+cppcms::views::pool::instance().add(my_generator);
+#line 14 "tests-flags/no-line.tmpl"
+}
+#line 14 "tests-flags/no-line.tmpl"
+~loader() { cppcms::views::pool::instance().remove(my_generator); }
+#line 14 "tests-flags/no-line.tmpl"
+} a_loader;
+#line 14 "tests-flags/no-line.tmpl"
+} // anon 
@@ -0,0 +1,34 @@
+#include "bench_data.h" 
+namespace no_line {
+struct page:public cppcms::base_view
+ {
+bench_data::page & content;
+page(std::ostream & _s, bench_data::page & _content):cppcms::base_view(_s),content(_content)
+{
+}
+virtual void render(){
+out() << "\n<h1>";
+out() << cppcms::filters::escape(content.title);
+out() << "</h1>\n";
+if(content.logged_in) {
+out() << "Hello ";
+out() << cppcms::filters::escape(content.user.name);
+}  // endif
+out() << "\n\n\n\n<p>far below</p>";
+out() << content.count; 
+out() << "\n";
+} // end of template render
+}; // end of class page
+} // end of namespace no_line
+
+namespace {
+cppcms::views::generator my_generator;
+struct loader {
+loader() {
+my_generator.name("no_line");
+my_generator.add_view< no_line::page, bench_data::page >("page", true);
+cppcms::views::pool::instance().add(my_generator);
+}
+~loader() { cppcms::views::pool::instance().remove(my_generator); }
+} a_loader;
+} // anon 
@@ -0,0 +1,82 @@
+#include <boost/format.hpp>
+#line 1 "tests-flags/perf-lint.tmpl"
+#include "bench_data.h" 
+#line 2 "tests-flags/perf-lint.tmpl"
+namespace perf_lint {
+#line 3 "tests-flags/perf-lint.tmpl"
+struct page:public cppcms::base_view
+#line 3 "tests-flags/perf-lint.tmpl"
+ {
+#line 3 "tests-flags/perf-lint.tmpl"
+bench_data::page & content;
+#line 3 "tests-flags/perf-lint.tmpl"
+page(std::ostream & _s, bench_data::page & _content):cppcms::base_view(_s),content(_content)
+#line 3 "tests-flags/perf-lint.tmpl"
+{
+#line 3 "tests-flags/perf-lint.tmpl"
+}
+#line 4 "tests-flags/perf-lint.tmpl"
+virtual void render(){
+#line 5 "tests-flags/perf-lint.tmpl"
+out() << "\n";
+#line 5 "tests-flags/perf-lint.tmpl"
+if(!(content.user.name.empty())) {
+#line 5 "tests-flags/perf-lint.tmpl"
+out() << "Hello ";
+#line 5 "tests-flags/perf-lint.tmpl"
+out() << cppcms::filters::escape(content.user.name);
+#line 5 "tests-flags/perf-lint.tmpl"
+}  // endif
+#line 6 "tests-flags/perf-lint.tmpl"
+out() << "\n";
+#line 6 "tests-flags/perf-lint.tmpl"
+if(content.user.name.empty()) {
+#line 6 "tests-flags/perf-lint.tmpl"
+out() << "Hello stranger";
+#line 6 "tests-flags/perf-lint.tmpl"
+}  // endif
+#line 7 "tests-flags/perf-lint.tmpl"
+out() << "\n";
+#line 7 "tests-flags/perf-lint.tmpl"
+if((content.items).begin() != (content.items).end()) {
+#line 7 "tests-flags/perf-lint.tmpl"
+for (CPPCMS_TYPEOF((content.items).begin()) it_ptr = (content.items).begin(), it_ptr_end = (content.items).end(); it_ptr != it_ptr_end; ++it_ptr) {
+#line 7 "tests-flags/perf-lint.tmpl"
+CPPCMS_TYPEOF(*it_ptr) & it = *it_ptr;
+#line 7 "tests-flags/perf-lint.tmpl"
+out() << cppcms::filters::escape((boost::format("{1} of {2}")% (it.title)% (content.title)).str());
+#line 7 "tests-flags/perf-lint.tmpl"
+} // end of item
+#line 7 "tests-flags/perf-lint.tmpl"
+}
+#line 8 "tests-flags/perf-lint.tmpl"
+out() << "\n";
+#line 8 "tests-flags/perf-lint.tmpl"
+} // end of template render
+#line 9 "tests-flags/perf-lint.tmpl"
+}; // end of class page
+#line 10 "tests-flags/perf-lint.tmpl"
+} // end of namespace perf_lint
+
+#line 11 "tests-flags/perf-lint.tmpl"
+namespace {
+#line 11 "tests-flags/perf-lint.tmpl"
+cppcms::views::generator my_generator;
+#line 11 "tests-flags/perf-lint.tmpl"
+struct loader {
+#line 11 "tests-flags/perf-lint.tmpl"
+loader() {
+#line 11 "tests-flags/perf-lint.tmpl"
+my_generator.name("perf_lint");
+#line 11 "tests-flags/perf-lint.tmpl"
+my_generator.add_view< perf_lint::page, bench_data::page >("page", true);
+#line 11 "tests-flags/perf-lint.tmpl"
+cppcms::views::pool::instance().add(my_generator);
+#line 11 "tests-flags/perf-lint.tmpl"
+}
+#line 11 "tests-flags/perf-lint.tmpl"
+~loader() { cppcms::views::pool::instance().remove(my_generator); }
+#line 11 "tests-flags/perf-lint.tmpl"
+} a_loader;
+#line 11 "tests-flags/perf-lint.tmpl"
+} // anon 
@@ -0,0 +1,79 @@
+#line 1 "tests-flags/size-report.tmpl"
+#include "bench_data.h" 
+#line 2 "tests-flags/size-report.tmpl"
+namespace size_report {
+#line 3 "tests-flags/size-report.tmpl"
+struct page:public cppcms::base_view
+#line 3 "tests-flags/size-report.tmpl"
+ {
+#line 3 "tests-flags/size-report.tmpl"
+bench_data::page & content;
+#line 3 "tests-flags/size-report.tmpl"
+page(std::ostream & _s, bench_data::page & _content):cppcms::base_view(_s),content(_content)
+#line 3 "tests-flags/size-report.tmpl"
+{
+#line 3 "tests-flags/size-report.tmpl"
+}
+#line 4 "tests-flags/size-report.tmpl"
+virtual void title(){
+#line 4 "tests-flags/size-report.tmpl"
+out() << "<h1>";
+#line 4 "tests-flags/size-report.tmpl"
+out() << cppcms::filters::escape(content.title);
+#line 4 "tests-flags/size-report.tmpl"
+out() << "</h1>";
+#line 4 "tests-flags/size-report.tmpl"
+} // end of template title
+#line 5 "tests-flags/size-report.tmpl"
+virtual void title(std::string const &prefix){
+#line 5 "tests-flags/size-report.tmpl"
+out() << "<h1>";
+#line 5 "tests-flags/size-report.tmpl"
+out() << cppcms::filters::escape(prefix);
+#line 5 "tests-flags/size-report.tmpl"
+out() << " ";
+#line 5 "tests-flags/size-report.tmpl"
+out() << cppcms::filters::escape(content.title);
+#line 5 "tests-flags/size-report.tmpl"
+out() << "</h1>";
+#line 5 "tests-flags/size-report.tmpl"
+} // end of template title
+#line 6 "tests-flags/size-report.tmpl"
+virtual void render(){
+#line 7 "tests-flags/size-report.tmpl"
+out() << "\n";
+#line 7 "tests-flags/size-report.tmpl"
+title(  );
+#line 7 "tests-flags/size-report.tmpl"
+title(  "Re:");
+#line 8 "tests-flags/size-report.tmpl"
+out() << "\n";
+#line 8 "tests-flags/size-report.tmpl"
+} // end of template render
+#line 9 "tests-flags/size-report.tmpl"
+}; // end of class page
+#line 10 "tests-flags/size-report.tmpl"
+} // end of namespace size_report
+
+#line 11 "tests-flags/size-report.tmpl"
+namespace {
+#line 11 "tests-flags/size-report.tmpl"
+cppcms::views::generator my_generator;
+#line 11 "tests-flags/size-report.tmpl"
+struct loader {
+#line 11 "tests-flags/size-report.tmpl"
+loader() {
+#line 11 "tests-flags/size-report.tmpl"
+my_generator.name("size_report");
+#line 11 "tests-flags/size-report.tmpl"
+my_generator.add_view< size_report::page, bench_data::page >("page", true);
+#line 11 "tests-flags/size-report.tmpl"
+cppcms::views::pool::instance().add(my_generator);
+#line 11 "tests-flags/size-report.tmpl"
+}
+#line 11 "tests-flags/size-report.tmpl"
+~loader() { cppcms::views::pool::instance().remove(my_generator); }
+#line 11 "tests-flags/size-report.tmpl"
+} a_loader;
+#line 11 "tests-flags/size-report.tmpl"
+} // anon 
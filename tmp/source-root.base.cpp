@@ -0,0 +1,53 @@
+#line 1 "tests-flags/source-root.tmpl"
+#include "bench_data.h" 
+#line 2 "tests-flags/source-root.tmpl"
+namespace source_root {
+#line 3 "tests-flags/source-root.tmpl"
+struct page:public cppcms::base_view
+#line 3 "tests-flags/source-root.tmpl"
+ {
+#line 3 "tests-flags/source-root.tmpl"
+bench_data::page & content;
+#line 3 "tests-flags/source-root.tmpl"
+page(std::ostream & _s, bench_data::page & _content):cppcms::base_view(_s),content(_content)
+#line 3 "tests-flags/source-root.tmpl"
+{
+#line 3 "tests-flags/source-root.tmpl"
+}
+#line 4 "tests-flags/source-root.tmpl"
+virtual void render(){
+#line 4 "tests-flags/source-root.tmpl"
+out() << "<h1>";
+#line 4 "tests-flags/source-root.tmpl"
+out() << cppcms::filters::escape(content.title);
+#line 5 "tests-flags/source-root.tmpl"
+out() << "</h1>\n";
+#line 5 "tests-flags/source-root.tmpl"
+} // end of template render
+#line 6 "tests-flags/source-root.tmpl"
+}; // end of class page
+#line 7 "tests-flags/source-root.tmpl"
+} // end of namespace source_root
+
+#line 8 "tests-flags/source-root.tmpl"
+namespace {
+#line 8 "tests-flags/source-root.tmpl"
+cppcms::views::generator my_generator;
+#line 8 "tests-flags/source-root.tmpl"
+struct loader {
+#line 8 "tests-flags/source-root.tmpl"
+loader() {
+#line 8 "tests-flags/source-root.tmpl"
+my_generator.name("source_root");
+#line 8 "tests-flags/source-root.tmpl"
+my_generator.add_view< source_root::page, bench_data::page >("page", true);
+#line 8 "tests-flags/source-root.tmpl"
+cppcms::views::pool::instance().add(my_generator);
+#line 8 "tests-flags/source-root.tmpl"
+}
+#line 8 "tests-flags/source-root.tmpl"
+~loader() { cppcms::views::pool::instance().remove(my_generator); }
+#line 8 "tests-flags/source-root.tmpl"
+} a_loader;
+#line 8 "tests-flags/source-root.tmpl"
+} // anon 
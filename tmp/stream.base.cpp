@@ -0,0 +1,80 @@
+#include <boost/format.hpp>
+#line 1 "tests-flags/stream.tmpl"
+#include "bench_data.h" 
+#line 2 "tests-flags/stream.tmpl"
+namespace stream {
+#line 3 "tests-flags/stream.tmpl"
+struct page:public cppcms::base_view
+#line 3 "tests-flags/stream.tmpl"
+ {
+#line 3 "tests-flags/stream.tmpl"
+bench_data::page & content;
+#line 3 "tests-flags/stream.tmpl"
+page(std::ostream & _s, bench_data::page & _content):cppcms::base_view(_s),content(_content)
+#line 3 "tests-flags/stream.tmpl"
+{
+#line 3 "tests-flags/stream.tmpl"
+}
+#line 4 "tests-flags/stream.tmpl"
+virtual void render(){
+#line 4 "tests-flags/stream.tmpl"
+out() << "<h1>";
+#line 4 "tests-flags/stream.tmpl"
+out() << cppcms::filters::escape(content.title);
+#line 5 "tests-flags/stream.tmpl"
+out() << "</h1>\n";
+#line 5 "tests-flags/stream.tmpl"
+} // end of template render
+#line 6 "tests-flags/stream.tmpl"
+}; // end of class page
+#line 7 "tests-flags/stream.tmpl"
+struct summary:public cppcms::base_view
+#line 7 "tests-flags/stream.tmpl"
+ {
+#line 7 "tests-flags/stream.tmpl"
+bench_data::page & content;
+#line 7 "tests-flags/stream.tmpl"
+summary(std::ostream & _s, bench_data::page & _content):cppcms::base_view(_s),content(_content)
+#line 7 "tests-flags/stream.tmpl"
+{
+#line 7 "tests-flags/stream.tmpl"
+}
+#line 8 "tests-flags/stream.tmpl"
+virtual void render(){
+#line 8 "tests-flags/stream.tmpl"
+out() << "<p>";
+#line 8 "tests-flags/stream.tmpl"
+out() << cppcms::filters::escape((boost::format("%1% items")% (content.count)).str());
+#line 9 "tests-flags/stream.tmpl"
+out() << "</p>\n";
+#line 9 "tests-flags/stream.tmpl"
+} // end of template render
+#line 10 "tests-flags/stream.tmpl"
+}; // end of class summary
+#line 11 "tests-flags/stream.tmpl"
+} // end of namespace stream
+
+#line 12 "tests-flags/stream.tmpl"
+namespace {
+#line 12 "tests-flags/stream.tmpl"
+cppcms::views::generator my_generator;
+#line 12 "tests-flags/stream.tmpl"
+struct loader {
+#line 12 "tests-flags/stream.tmpl"
+loader() {
+#line 12 "tests-flags/stream.tmpl"
+my_generator.name("stream");
+#line 12 "tests-flags/stream.tmpl"
+my_generator.add_view< stream::page, bench_data::page >("page", true);
+#line 12 "tests-flags/stream.tmpl"
+my_generator.add_view< stream::summary, bench_data::page >("summary", true);
+#line 12 "tests-flags/stream.tmpl"
+cppcms::views::pool::instance().add(my_generator);
+#line 12 "tests-flags/stream.tmpl"
+}
+#line 12 "tests-flags/stream.tmpl"
+~loader() { cppcms::views::pool::instance().remove(my_generator); }
+#line 12 "tests-flags/stream.tmpl"
+} a_loader;
+#line 12 "tests-flags/stream.tmpl"
+} // anon 
@@ -0,0 +1,61 @@
+#line 1 "tests-flags/trace-out.tmpl"
+#include "bench_data.h" 
+#line 2 "tests-flags/trace-out.tmpl"
+namespace trace_out {
+#line 3 "tests-flags/trace-out.tmpl"
+struct page:public cppcms::base_view
+#line 3 "tests-flags/trace-out.tmpl"
+ {
+#line 3 "tests-flags/trace-out.tmpl"
+bench_data::page & content;
+#line 3 "tests-flags/trace-out.tmpl"
+page(std::ostream & _s, bench_data::page & _content):cppcms::base_view(_s),content(_content)
+#line 3 "tests-flags/trace-out.tmpl"
+{
+#line 3 "tests-flags/trace-out.tmpl"
+}
+#line 4 "tests-flags/trace-out.tmpl"
+virtual void title(){
+#line 4 "tests-flags/trace-out.tmpl"
+out() << "<h1>";
+#line 4 "tests-flags/trace-out.tmpl"
+out() << cppcms::filters::escape(content.title);
+#line 4 "tests-flags/trace-out.tmpl"
+out() << "</h1>";
+#line 4 "tests-flags/trace-out.tmpl"
+} // end of template title
+#line 5 "tests-flags/trace-out.tmpl"
+virtual void render(){
+#line 5 "tests-flags/trace-out.tmpl"
+title(  );
+#line 6 "tests-flags/trace-out.tmpl"
+out() << "\n";
+#line 6 "tests-flags/trace-out.tmpl"
+} // end of template render
+#line 7 "tests-flags/trace-out.tmpl"
+}; // end of class page
+#line 8 "tests-flags/trace-out.tmpl"
+} // end of namespace trace_out
+
+#line 9 "tests-flags/trace-out.tmpl"
+namespace {
+#line 9 "tests-flags/trace-out.tmpl"
+cppcms::views::generator my_generator;
+#line 9 "tests-flags/trace-out.tmpl"
+struct loader {
+#line 9 "tests-flags/trace-out.tmpl"
+loader() {
+#line 9 "tests-flags/trace-out.tmpl"
+my_generator.name("trace_out");
+#line 9 "tests-flags/trace-out.tmpl"
+my_generator.add_view< trace_out::page, bench_data::page >("page", true);
+#line 9 "tests-flags/trace-out.tmpl"
+cppcms::views::pool::instance().add(my_generator);
+#line 9 "tests-flags/trace-out.tmpl"
+}
+#line 9 "tests-flags/trace-out.tmpl"
+~loader() { cppcms::views::pool::instance().remove(my_generator); }
+#line 9 "tests-flags/trace-out.tmpl"
+} a_loader;
+#line 9 "tests-flags/trace-out.tmpl"
+} // anon 